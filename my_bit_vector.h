@@ -0,0 +1,469 @@
+#ifndef MY_BIT_VECTOR_H
+#define MY_BIT_VECTOR_H
+
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "my_vector.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define MY_BIT_VECTOR_X86 1
+#include <immintrin.h>
+#endif
+
+// Interface : https://en.cppreference.com/w/cpp/container/vector_bool and https://en.cppreference.com/w/cpp/utility/bitset
+
+namespace cpp_training {
+
+namespace detail {
+
+inline size_t popcount(uint64_t word) {
+    return __builtin_popcountll(word);
+}
+
+inline size_t count_trailing_zeros(uint64_t word) {
+    return __builtin_ctzll(word);
+}
+
+// Portable select_in_word(): clears the k lowest set bits
+inline size_t select_in_word_loop(uint64_t word, size_t k) {
+    for (; k; --k) word &= word - 1;
+    return count_trailing_zeros(word);
+}
+
+#ifdef MY_BIT_VECTOR_X86
+
+//
+// BMI2 version, compiled for that target whatever the flags of the translation unit
+//
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("bmi2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("bmi2")
+#endif
+
+namespace bmi2 {
+
+// PDEP deposits the single bit 1 << k at the position of the k-th set bit of word
+inline size_t select_in_word(uint64_t word, size_t k) {
+    return count_trailing_zeros(_pdep_u64(uint64_t(1) << k, word));
+}
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif // MY_BIT_VECTOR_X86
+
+inline bool has_bmi2() {
+#ifdef MY_BIT_VECTOR_X86
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("bmi2") != 0);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// Position of the k-th (from 0) set bit of word, which has more than k set bits. PDEP when the CPU has BMI2
+inline size_t select_in_word(uint64_t word, size_t k) {
+#ifdef MY_BIT_VECTOR_X86
+    if (has_bmi2()) return bmi2::select_in_word(word, k);
+#endif
+    return select_in_word_loop(word, k);
+}
+
+}
+
+// Bits packed in 64 bit words of a my_vector<uint64_t>, 8 times smaller than my_vector<bool>.
+// Counting, searching and the bitwise operators work a word at a time.
+// Bits past size() in the last word are always zero, so whole words can be counted and compared.
+class my_bit_vector {
+    template <bool Const>
+    class bit_iterator;
+
+public:
+    static constexpr size_t WordBits = 64;
+
+    // Proxy for a single bit
+    class reference {
+        friend class my_bit_vector;
+    public:
+        operator bool () const { return (*m_word_p & m_mask) != 0; }
+
+        reference& operator = (bool value) {
+            if (value) *m_word_p |= m_mask; else *m_word_p &= ~m_mask;
+            return *this;
+        }
+
+        reference& operator = (const reference& rhs) { return *this = static_cast<bool>(rhs); }
+
+        bool operator ~ () const { return !static_cast<bool>(*this); }
+
+        void flip() { *m_word_p ^= m_mask; }
+
+    private:
+        reference(uint64_t* word_p, uint64_t mask) : m_word_p(word_p), m_mask(mask) {}
+
+    private:
+        uint64_t* m_word_p;
+        uint64_t m_mask;
+    };
+
+    using value_type = bool;
+    using const_reference = bool;
+    using iterator = bit_iterator<false>;
+    using const_iterator = bit_iterator<true>;
+
+public:
+
+    my_bit_vector() {
+    }
+
+    explicit my_bit_vector(size_t size, bool value = false)
+        : m_words(word_count(size), value ? ~uint64_t(0) : 0), m_size(size) {
+        clear_tail();
+    }
+
+    my_bit_vector(std::initializer_list<bool> lst) : my_bit_vector(lst.size()) {
+        size_t i = 0;
+        for (auto bit : lst) set(i++, bit);
+    }
+
+    // Packs an unpacked bitmap
+    explicit my_bit_vector(const my_vector<bool>& bits) : my_bit_vector(bits.size()) {
+        for (size_t i = 0; i < m_size; ++i) {
+            if (bits[i]) set(i);
+        }
+    }
+
+    size_t size() const { return m_size; }
+
+    bool is_empty() const { return m_size == 0; }
+
+    // The underlying words, bit i is bit i % 64 of word i / 64
+    const my_vector<uint64_t>& words() const { return m_words; }
+
+    reference operator [] (size_t i) { return reference(&m_words[i / WordBits], bit_mask(i)); }
+
+    bool operator [] (size_t i) const { return test(i); }
+
+    bool test(size_t i) const { return (m_words[i / WordBits] & bit_mask(i)) != 0; }
+
+    reference at(size_t i) {
+        if (i >= m_size) throw std::out_of_range("pos is out of range");
+        return (*this)[i];
+    }
+
+    bool at(size_t i) const {
+        if (i >= m_size) throw std::out_of_range("pos is out of range");
+        return test(i);
+    }
+
+    void set(size_t i, bool value = true) { (*this)[i] = value; }
+
+    void reset(size_t i) { m_words[i / WordBits] &= ~bit_mask(i); }
+
+    void flip(size_t i) { m_words[i / WordBits] ^= bit_mask(i); }
+
+    // Sets (or resets) all bits
+    void assign_all(bool value) {
+        for (auto& word : m_words) word = value ? ~uint64_t(0) : 0;
+        clear_tail();
+    }
+
+    void flip_all() {
+        for (auto& word : m_words) word = ~word;
+        clear_tail();
+    }
+
+    void push_back(bool value) {
+        if (m_size % WordBits == 0) m_words.push_back(0);
+        ++m_size;
+        set(m_size - 1, value);
+    }
+
+    void pop_back() {
+        if (m_size) {
+            reset(--m_size);
+            if (m_size % WordBits == 0) m_words.pop_back();
+        }
+    }
+
+    void resize(size_t count, bool value = false) {
+        if (value && count > m_size && m_size % WordBits) {
+            // The rest of the old last word, new words come filled
+            m_words.back() |= ~uint64_t(0) << (m_size % WordBits);
+        }
+        m_words.resize(word_count(count), value ? ~uint64_t(0) : 0);
+        m_size = count;
+        clear_tail();
+    }
+
+    void reserve(size_t new_cap) { m_words.reserve(word_count(new_cap)); }
+
+    void clear() {
+        m_words.clear();
+        m_size = 0;
+    }
+
+    void swap(my_bit_vector& rhs) noexcept {
+        m_words.swap(rhs.m_words);
+        std::swap(m_size, rhs.m_size);
+    }
+
+    // Number of set bits
+    size_t count() const {
+        size_t result = 0;
+        for (auto word : m_words) result += detail::popcount(word);
+        return result;
+    }
+
+    bool any() const {
+        for (auto word : m_words) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    bool none() const { return !any(); }
+
+    bool all() const { return count() == m_size; }
+
+    // Position of the first set bit, size() if there is none
+    size_t find_first() const { return find_from(0); }
+
+    // Position of the first set bit after pos, size() if there is none
+    size_t find_next(size_t pos) const { return find_from(pos + 1); }
+
+    // Bitwise operations with a vector of the same size, throw std::invalid_argument otherwise
+    my_bit_vector& operator &= (const my_bit_vector& rhs) {
+        check_same_size(rhs);
+        for (size_t w = 0; w < m_words.size(); ++w) m_words[w] &= rhs.m_words[w];
+        return *this;
+    }
+
+    my_bit_vector& operator |= (const my_bit_vector& rhs) {
+        check_same_size(rhs);
+        for (size_t w = 0; w < m_words.size(); ++w) m_words[w] |= rhs.m_words[w];
+        return *this;
+    }
+
+    my_bit_vector& operator ^= (const my_bit_vector& rhs) {
+        check_same_size(rhs);
+        for (size_t w = 0; w < m_words.size(); ++w) m_words[w] ^= rhs.m_words[w];
+        return *this;
+    }
+
+    // Clears the bits set in rhs, *this &= ~rhs without the temporary
+    my_bit_vector& and_not(const my_bit_vector& rhs) {
+        check_same_size(rhs);
+        for (size_t w = 0; w < m_words.size(); ++w) m_words[w] &= ~rhs.m_words[w];
+        return *this;
+    }
+
+    my_bit_vector operator ~ () const {
+        my_bit_vector result(*this);
+        result.flip_all();
+        return result;
+    }
+
+    friend my_bit_vector operator & (my_bit_vector lhs, const my_bit_vector& rhs) {
+        lhs &= rhs;
+        return lhs;
+    }
+
+    friend my_bit_vector operator | (my_bit_vector lhs, const my_bit_vector& rhs) {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    friend my_bit_vector operator ^ (my_bit_vector lhs, const my_bit_vector& rhs) {
+        lhs ^= rhs;
+        return lhs;
+    }
+
+    bool operator == (const my_bit_vector& rhs) const { return m_size == rhs.m_size && m_words == rhs.m_words; }
+
+    bool operator != (const my_bit_vector& rhs) const { return !(*this == rhs); }
+
+    // Unpacks into one bool per element
+    my_vector<bool> to_vector() const {
+        my_vector<bool> result;
+        result.reserve(m_size);
+        for (size_t i = 0; i < m_size; ++i) result.push_back(test(i));
+        return result;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, m_size); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator cend() const noexcept { return const_iterator(this, m_size); }
+
+private:
+    static size_t word_count(size_t bits) { return (bits + WordBits - 1) / WordBits; }
+
+    static uint64_t bit_mask(size_t i) { return uint64_t(1) << (i % WordBits); }
+
+    void clear_tail() {
+        if (m_size % WordBits) m_words.back() &= (uint64_t(1) << (m_size % WordBits)) - 1;
+    }
+
+    void check_same_size(const my_bit_vector& rhs) const {
+        if (m_size != rhs.m_size) throw std::invalid_argument("bit vectors differ in size");
+    }
+
+    size_t find_from(size_t pos) const {
+        if (pos >= m_size) return m_size;
+        auto w = pos / WordBits;
+        // Drop the bits before pos in the first word
+        auto word = m_words[w] & (~uint64_t(0) << (pos % WordBits));
+        while (!word) {
+            if (++w == m_words.size()) return m_size;
+            word = m_words[w];
+        }
+        return w * WordBits + detail::count_trailing_zeros(word);
+    }
+
+    //
+    // Random access iterator, dereferences to reference (bool for the const one)
+    //
+    template <bool Const>
+    class bit_iterator {
+        using owner_type = std::conditional_t<Const, const my_bit_vector, my_bit_vector>;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = ptrdiff_t;
+        using reference = std::conditional_t<Const, bool, my_bit_vector::reference>;
+        using pointer = void;
+    public:
+        bit_iterator() {}
+        bit_iterator(owner_type* owner_p, size_t pos) : m_owner_p(owner_p), m_pos(pos) {}
+        operator bit_iterator<true> () const { return bit_iterator<true>(m_owner_p, m_pos); }
+        bit_iterator operator ++ (int) { return bit_iterator(m_owner_p, m_pos++); }
+        bit_iterator& operator ++ () { ++m_pos; return *this; }
+        bit_iterator operator -- (int) { return bit_iterator(m_owner_p, m_pos--); }
+        bit_iterator& operator -- () { --m_pos; return *this; }
+        difference_type operator - (bit_iterator rhs) const { return static_cast<difference_type>(m_pos - rhs.m_pos); }
+        bit_iterator& operator += (difference_type n) { m_pos += n; return *this; }
+        bit_iterator& operator -= (difference_type n) { m_pos -= n; return *this; }
+        bit_iterator operator - (difference_type n) const { return bit_iterator(m_owner_p, m_pos - n); }
+        bit_iterator operator + (difference_type n) const { return bit_iterator(m_owner_p, m_pos + n); }
+        reference operator * () const { return (*m_owner_p)[m_pos]; }
+        reference operator [] (difference_type n) const { return (*m_owner_p)[m_pos + n]; }
+        bool operator == (bit_iterator rhs) const { return m_pos == rhs.m_pos; }
+        bool operator != (bit_iterator rhs) const { return m_pos != rhs.m_pos; }
+        bool operator < (bit_iterator rhs) const { return m_pos < rhs.m_pos; }
+        bool operator > (bit_iterator rhs) const { return m_pos > rhs.m_pos; }
+    private:
+        owner_type* m_owner_p = nullptr;
+        size_t m_pos = 0;
+    };
+
+private:
+    my_vector<uint64_t> m_words;
+    size_t m_size = 0;
+};
+
+// Constant time rank and fast select over a my_bit_vector, which must outlive it and stay unchanged.
+// Keeps the number of set bits before every block of 512 bits (8 words, one cache line),
+// about 12.5% of the bit vector's size.
+class my_rank_select {
+public:
+    static constexpr size_t BlockWords = 8;
+    static constexpr size_t BlockBits = BlockWords * my_bit_vector::WordBits;
+
+public:
+
+    explicit my_rank_select(const my_bit_vector& bits) : m_bits_p(&bits) {
+        auto& words = bits.words();
+        size_t ones = 0;
+        m_block_ranks.reserve(words.size() / BlockWords + 2);
+        for (size_t w = 0; w < words.size(); ++w) {
+            if (w % BlockWords == 0) m_block_ranks.push_back(ones);
+            ones += detail::popcount(words[w]);
+        }
+        // Sentinel, the total
+        m_block_ranks.push_back(ones);
+    }
+
+    size_t size() const { return m_bits_p->size(); }
+
+    size_t count() const { return m_block_ranks.back(); }
+
+    // Number of set bits in [0, pos), pos <= size()
+    size_t rank1(size_t pos) const {
+        auto& words = m_bits_p->words();
+        auto w = pos / my_bit_vector::WordBits;
+        auto result = m_block_ranks[w / BlockWords];
+        for (size_t i = w / BlockWords * BlockWords; i < w; ++i) {
+            result += detail::popcount(words[i]);
+        }
+        if (pos % my_bit_vector::WordBits) {
+            result += detail::popcount(words[w] << (my_bit_vector::WordBits - pos % my_bit_vector::WordBits));
+        }
+        return result;
+    }
+
+    // Number of clear bits in [0, pos), pos <= size()
+    size_t rank0(size_t pos) const { return pos - rank1(pos); }
+
+    // Position of the k-th (from 0) set bit, size() if there are not that many
+    size_t select1(size_t k) const { return select<true>(k); }
+
+    // Position of the k-th (from 0) clear bit, size() if there are not that many
+    size_t select0(size_t k) const { return select<false>(k); }
+
+private:
+    // Ones (or zeros) before block b
+    template <bool One>
+    size_t block_rank(size_t b) const {
+        return One ? m_block_ranks[b] : std::min(b * BlockBits, size()) - m_block_ranks[b];
+    }
+
+    // Binary search for the block, then a scan of at most 8 words
+    template <bool One>
+    size_t select(size_t k) const {
+        auto blocks = m_block_ranks.size() - 1;
+        if (k >= block_rank<One>(blocks)) return size();
+        // The last block with rank <= k
+        size_t lo = 0, hi = blocks;
+        while (hi - lo > 1) {
+            auto mid = (lo + hi) / 2;
+            if (block_rank<One>(mid) <= k) lo = mid; else hi = mid;
+        }
+        k -= block_rank<One>(lo);
+        auto& words = m_bits_p->words();
+        for (auto w = lo * BlockWords;; ++w) {
+            // Zeros past size() in the last word are padding, but k is below the total, so they are never reached
+            auto word = One ? words[w] : ~words[w];
+            auto ones = detail::popcount(word);
+            if (k < ones) return w * my_bit_vector::WordBits + detail::select_in_word(word, k);
+            k -= ones;
+        }
+    }
+
+private:
+    const my_bit_vector* m_bits_p;
+    my_vector<size_t> m_block_ranks;
+};
+
+}
+
+#endif // MY_BIT_VECTOR_H
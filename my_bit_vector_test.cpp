@@ -0,0 +1,156 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_bit_vector.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace cpp_training;
+
+namespace {
+
+my_bit_vector random_bits(size_t size, double density, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::bernoulli_distribution dist(density);
+    my_bit_vector bits;
+    for (size_t i = 0; i < size; ++i) bits.push_back(dist(gen));
+    return bits;
+}
+
+}
+
+TEST(MyBitVectorTest, Construction) {
+    my_bit_vector empty;
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_EQ(empty.count(), 0);
+    EXPECT_EQ(empty.find_first(), 0);
+
+    my_bit_vector ones(100, true);
+    EXPECT_EQ(ones.size(), 100);
+    EXPECT_EQ(ones.count(), 100);
+    EXPECT_EQ(ones.words().size(), 2);
+    EXPECT_TRUE(ones.all());
+
+    my_bit_vector lst {true, false, true};
+    EXPECT_TRUE(lst[0]);
+    EXPECT_FALSE(lst[1]);
+    EXPECT_EQ(lst.count(), 2);
+    EXPECT_THROW(lst.at(3), std::out_of_range);
+
+    my_vector<bool> unpacked {false, true, true, false};
+    my_bit_vector packed(unpacked);
+    EXPECT_EQ(packed.count(), 2);
+    EXPECT_EQ(packed.to_vector(), unpacked);
+}
+
+TEST(MyBitVectorTest, Reference) {
+    my_bit_vector bits(70);
+    bits[65] = true;
+    EXPECT_TRUE(bits.test(65));
+    bits[3] = bits[65];
+    EXPECT_TRUE(bits[3]);
+    bits[3].flip();
+    EXPECT_FALSE(bits[3]);
+    EXPECT_TRUE(~bits[3]);
+    bits.flip(0);
+    bits.reset(65);
+    EXPECT_EQ(bits.find_first(), 0);
+    EXPECT_EQ(bits.find_next(0), 70);
+
+    for (auto bit : bits) {
+        bit = true;
+    }
+    EXPECT_TRUE(bits.all());
+    const auto& cbits = bits;
+    EXPECT_EQ(std::count(cbits.begin(), cbits.end(), true), 70);
+}
+
+TEST(MyBitVectorTest, ResizeKeepsTailClear) {
+    my_bit_vector bits(10);
+    bits.resize(130, true);
+    EXPECT_EQ(bits.count(), 120);
+    EXPECT_FALSE(bits[9]);
+    EXPECT_TRUE(bits[10]);
+    bits.resize(65);
+    EXPECT_EQ(bits.count(), 55);
+    bits.flip_all();
+    EXPECT_EQ(bits.count(), 10);
+    bits.resize(200);
+    EXPECT_EQ(bits.count(), 10);
+    for (int i = 0; i < 136; ++i) bits.pop_back();
+    EXPECT_EQ(bits.size(), 64);
+    EXPECT_EQ(bits.words().size(), 1);
+    bits.assign_all(true);
+    EXPECT_EQ(bits.count(), 64);
+}
+
+TEST(MyBitVectorTest, FindMatchesModel) {
+    auto bits = random_bits(1000, 0.02, 1);
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        if (bits[i]) expected.push_back(i);
+    }
+    std::vector<size_t> found;
+    for (auto i = bits.find_first(); i < bits.size(); i = bits.find_next(i)) {
+        found.push_back(i);
+    }
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(bits.count(), expected.size());
+}
+
+TEST(MyBitVectorTest, BitwiseOperations) {
+    auto a = random_bits(333, 0.5, 2), b = random_bits(333, 0.5, 3);
+    auto both = a & b, either = a | b, differ = a ^ b;
+    auto only_a = a;
+    only_a.and_not(b);
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(both[i], a[i] && b[i]);
+        ASSERT_EQ(either[i], a[i] || b[i]);
+        ASSERT_EQ(differ[i], a[i] != b[i]);
+        ASSERT_EQ(only_a[i], a[i] && !b[i]);
+    }
+    EXPECT_EQ((~a).count(), a.size() - a.count());
+    EXPECT_EQ(a ^ a, my_bit_vector(333));
+    EXPECT_THROW(a &= my_bit_vector(10), std::invalid_argument);
+}
+
+TEST(MyBitVectorTest, RankSelect) {
+    for (double density : {0.0, 0.01, 0.5, 1.0}) {
+        auto bits = random_bits(5000, density, 4);
+        my_rank_select rs(bits);
+        EXPECT_EQ(rs.count(), bits.count());
+        size_t ones = 0, zeros = 0;
+        for (size_t i = 0; i <= bits.size(); ++i) {
+            ASSERT_EQ(rs.rank1(i), ones);
+            ASSERT_EQ(rs.rank0(i), zeros);
+            if (i == bits.size()) break;
+            if (bits[i]) {
+                ASSERT_EQ(rs.select1(ones++), i);
+            } else {
+                ASSERT_EQ(rs.select0(zeros++), i);
+            }
+        }
+        EXPECT_EQ(rs.select1(ones), bits.size());
+        EXPECT_EQ(rs.select0(zeros), bits.size());
+    }
+}
+
+TEST(MyBitVectorTest, SelectInWord) {
+    // The select above uses PDEP when the CPU has BMI2, this checks both versions against a scan of the bits
+    std::mt19937_64 gen(5);
+    for (int round = 0; round < 1000; ++round) {
+        auto word = round % 3 ? gen() : gen() & gen() & gen();
+        if (round == 0) word = ~uint64_t(0);
+        if (word == 0) continue;
+        size_t k = 0;
+        for (size_t bit = 0; bit < 64; ++bit) {
+            if (!(word >> bit & 1)) continue;
+            ASSERT_EQ(detail::select_in_word_loop(word, k), bit);
+#ifdef MY_BIT_VECTOR_X86
+            if (detail::has_bmi2()) ASSERT_EQ(detail::bmi2::select_in_word(word, k), bit) << std::hex << word;
+#endif
+            ++k;
+        }
+    }
+}
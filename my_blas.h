@@ -0,0 +1,718 @@
+#ifndef MY_BLAS_H
+#define MY_BLAS_H
+
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_span.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MY_BLAS_X86 1
+#include <immintrin.h>
+#endif
+
+// Interface after the level 1 BLAS : https://netlib.org/blas/#_level_1
+
+namespace cpp_training {
+
+namespace blas {
+
+// Instruction set of the kernels. The best one the CPU supports is chosen on first use
+enum class simd_level {
+    scalar,
+    avx2,           // With FMA
+    avx512          // AVX-512F
+};
+
+// How the reductions (dot, asum, nrm2) add up
+enum class accuracy {
+    fast,           // Several vector accumulators, the error bound grows with n
+    pairwise,       // Blocks of PairwiseBlock added pairwise, the error bound grows with log n. Free for short vectors
+    compensated     // Kahan-Babuska per lane (Dot2 for dot products), about as accurate as twice the precision
+};
+
+namespace detail {
+
+constexpr size_t PairwiseBlock = 1024;
+
+template <typename T>
+using no_deduce = std::enable_if_t<true, T>;
+
+template <typename T>
+struct is_blas_type : std::integral_constant<bool, std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+inline simd_level detect_simd_level() {
+#ifdef MY_BLAS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return simd_level::avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return simd_level::avx2;
+#endif
+    return simd_level::scalar;
+}
+
+//
+// Portable kernels, also the tails of the vector ones
+//
+namespace scalar {
+
+template <typename T>
+void axpy(size_t n, T a, const T* x, T* y) {
+    for (size_t i = 0; i < n; ++i) y[i] += a * x[i];
+}
+
+template <typename T>
+void scal(size_t n, T a, T* x) {
+    for (size_t i = 0; i < n; ++i) x[i] *= a;
+}
+
+// Error free transformation: s + e == a + b exactly (Knuth's TwoSum, no branch)
+template <typename T>
+void two_sum(T a, T b, T& s, T& e) {
+    s = a + b;
+    T z = s - a;
+    e = (a - (s - z)) + (b - z);
+}
+
+template <typename T>
+T compensated_sum(const T* values, size_t n) {
+    T s = 0, c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        T e;
+        two_sum(s, values[i], s, e);
+        c += e;
+    }
+    return s + c;
+}
+
+template <typename T>
+T dot_fast(size_t n, const T* x, const T* y) {
+    constexpr size_t Lanes = 4;
+    T partial[Lanes] = {};
+    size_t i = 0;
+    for (; i + Lanes <= n; i += Lanes) {
+        for (size_t k = 0; k < Lanes; ++k) partial[k] += x[i + k] * y[i + k];
+    }
+    for (; i < n; ++i) partial[0] += x[i] * y[i];
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+// Ogita, Rump and Oishi's Dot2: the rounding error of every product (from an fma) and of every addition is kept
+template <typename T>
+T dot_compensated(size_t n, const T* x, const T* y) {
+    T s = 0, c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        T p = x[i] * y[i];
+        T pe = std::fma(x[i], y[i], -p);
+        T e;
+        two_sum(s, p, s, e);
+        c += e + pe;
+    }
+    return s + c;
+}
+
+template <typename T>
+T asum_fast(size_t n, const T* x) {
+    constexpr size_t Lanes = 4;
+    T partial[Lanes] = {};
+    size_t i = 0;
+    for (; i + Lanes <= n; i += Lanes) {
+        for (size_t k = 0; k < Lanes; ++k) partial[k] += std::abs(x[i + k]);
+    }
+    for (; i < n; ++i) partial[0] += std::abs(x[i]);
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+template <typename T>
+T asum_compensated(size_t n, const T* x) {
+    T s = 0, c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        T e;
+        two_sum(s, std::abs(x[i]), s, e);
+        c += e;
+    }
+    return s + c;
+}
+
+// Inclusive scan, carry is the sum before x[0]
+template <typename T>
+void prefix_sum(size_t n, T* x, T carry = 0) {
+    for (size_t i = 0; i < n; ++i) x[i] = carry += x[i];
+}
+
+// Inclusive scan with a Kahan running sum: the rounding error of each addition is carried into the next
+// addend rather than accumulated on the side, so it stays below half an ulp of the sum and every output is close
+// to the exact sum so far
+template <typename T>
+void prefix_sum_compensated(size_t n, T* x) {
+    T s = 0, c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        two_sum(s, x[i] + c, s, c);
+        x[i] = s;
+    }
+}
+
+// Largest magnitude, NaN if there is one
+template <typename T>
+T amax(size_t n, const T* x) {
+    T result = 0;
+    for (size_t i = 0; i < n; ++i) {
+        T a = std::abs(x[i]);
+        if (a > result || std::isnan(a)) result = a;
+        if (std::isnan(result)) break;
+    }
+    return result;
+}
+
+template <typename T>
+T sum_of_scaled_squares(size_t n, const T* x, T scale, bool compensated) {
+    T s = 0, c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        T v = x[i] * scale;
+        if (compensated) {
+            T e;
+            two_sum(s, v * v, s, e);
+            c += e;
+        } else {
+            s += v * v;
+        }
+    }
+    return s + c;
+}
+
+}
+
+#ifdef MY_BLAS_X86
+
+//
+// AVX2 + FMA kernels, compiled for that target whatever the flags of the translation unit
+//
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+namespace avx2 {
+
+template <typename T>
+constexpr size_t Width = 32 / sizeof(T);
+
+inline __m256 load(const float* p) { return _mm256_loadu_ps(p); }
+inline __m256d load(const double* p) { return _mm256_loadu_pd(p); }
+inline void store(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+inline void store(double* p, __m256d v) { _mm256_storeu_pd(p, v); }
+inline __m256 broadcast(float a) { return _mm256_set1_ps(a); }
+inline __m256d broadcast(double a) { return _mm256_set1_pd(a); }
+inline __m256 add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+inline __m256d add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+inline __m256 sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+inline __m256d sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+inline __m256 mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+inline __m256d mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+inline __m256 fmadd(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+inline __m256d fmadd(__m256d a, __m256d b, __m256d c) { return _mm256_fmadd_pd(a, b, c); }
+inline __m256 fmsub(__m256 a, __m256 b, __m256 c) { return _mm256_fmsub_ps(a, b, c); }
+inline __m256d fmsub(__m256d a, __m256d b, __m256d c) { return _mm256_fmsub_pd(a, b, c); }
+inline __m256 abs(__m256 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+inline __m256d abs(__m256d a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+// Inclusive scan of the register: within each 128 bit lane by shifts, then the low lane total into the high lane
+inline __m256 scan(__m256 v) {
+    v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4)));
+    v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 8)));
+    auto low = _mm256_permute2f128_ps(v, v, 0x08);
+    return _mm256_add_ps(v, _mm256_shuffle_ps(low, low, 0xFF));
+}
+
+inline __m256d scan(__m256d v) {
+    v = _mm256_add_pd(v, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(v), 8)));
+    auto low = _mm256_permute2f128_pd(v, v, 0x08);
+    return _mm256_add_pd(v, _mm256_permute_pd(low, 0xF));
+}
+
+inline __m256 broadcast_last(__m256 v) { return _mm256_permutevar8x32_ps(v, _mm256_set1_epi32(7)); }
+inline __m256d broadcast_last(__m256d v) { return _mm256_permute4x64_pd(v, 0xFF); }
+
+template <typename T, typename V>
+T horizontal_sum(V v) {
+    alignas(32) T lanes[Width<T>];
+    store(lanes, v);
+    T result = 0;
+    for (auto lane : lanes) result += lane;
+    return result;
+}
+
+template <typename V>
+void two_sum_add(V& s, V& c, V v) {
+    auto t = add(s, v);
+    auto z = sub(t, s);
+    c = add(c, add(sub(s, sub(t, z)), sub(v, z)));
+    s = t;
+}
+
+// Exact sum of the lanes of s and c, with the tail from the scalar kernel
+template <typename T, typename V>
+T finish_compensated(V s, V c, T tail) {
+    alignas(32) T lanes[2 * Width<T> + 1];
+    store(lanes, s);
+    store(lanes + Width<T>, c);
+    lanes[2 * Width<T>] = tail;
+    return scalar::compensated_sum(lanes, 2 * Width<T> + 1);
+}
+
+template <typename T>
+void axpy(size_t n, T a, const T* x, T* y) {
+    constexpr auto W = Width<T>;
+    auto va = broadcast(a);
+    size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+        store(y + i, fmadd(va, load(x + i), load(y + i)));
+        store(y + i + W, fmadd(va, load(x + i + W), load(y + i + W)));
+    }
+    for (; i + W <= n; i += W) store(y + i, fmadd(va, load(x + i), load(y + i)));
+    scalar::axpy(n - i, a, x + i, y + i);
+}
+
+template <typename T>
+void scal(size_t n, T a, T* x) {
+    constexpr auto W = Width<T>;
+    auto va = broadcast(a);
+    size_t i = 0;
+    for (; i + W <= n; i += W) store(x + i, mul(va, load(x + i)));
+    scalar::scal(n - i, a, x + i);
+}
+
+// Four accumulators hide the latency of the fma
+template <typename T>
+T dot_fast(size_t n, const T* x, const T* y) {
+    constexpr auto W = Width<T>;
+    auto s0 = broadcast(T(0)), s1 = s0, s2 = s0, s3 = s0;
+    size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+        s0 = fmadd(load(x + i), load(y + i), s0);
+        s1 = fmadd(load(x + i + W), load(y + i + W), s1);
+        s2 = fmadd(load(x + i + 2 * W), load(y + i + 2 * W), s2);
+        s3 = fmadd(load(x + i + 3 * W), load(y + i + 3 * W), s3);
+    }
+    for (; i + W <= n; i += W) s0 = fmadd(load(x + i), load(y + i), s0);
+    return horizontal_sum<T>(add(add(s0, s1), add(s2, s3))) + scalar::dot_fast(n - i, x + i, y + i);
+}
+
+template <typename T>
+T dot_compensated(size_t n, const T* x, const T* y) {
+    constexpr auto W = Width<T>;
+    auto s = broadcast(T(0)), c = s;
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        auto vx = load(x + i);
+        auto vy = load(y + i);
+        auto p = mul(vx, vy);
+        c = add(c, fmsub(vx, vy, p));
+        two_sum_add(s, c, p);
+    }
+    return finish_compensated(s, c, scalar::dot_compensated(n - i, x + i, y + i));
+}
+
+template <typename T>
+T asum_fast(size_t n, const T* x) {
+    constexpr auto W = Width<T>;
+    auto s0 = broadcast(T(0)), s1 = s0;
+    size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+        s0 = add(s0, abs(load(x + i)));
+        s1 = add(s1, abs(load(x + i + W)));
+    }
+    for (; i + W <= n; i += W) s0 = add(s0, abs(load(x + i)));
+    return horizontal_sum<T>(add(s0, s1)) + scalar::asum_fast(n - i, x + i);
+}
+
+template <typename T>
+T asum_compensated(size_t n, const T* x) {
+    constexpr auto W = Width<T>;
+    auto s = broadcast(T(0)), c = s;
+    size_t i = 0;
+    for (; i + W <= n; i += W) two_sum_add(s, c, abs(load(x + i)));
+    return finish_compensated(s, c, scalar::asum_compensated(n - i, x + i));
+}
+
+template <typename T>
+void prefix_sum(size_t n, T* x) {
+    constexpr auto W = Width<T>;
+    auto carry = broadcast(T(0));
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        auto v = add(scan(load(x + i)), carry);
+        store(x + i, v);
+        carry = broadcast_last(v);
+    }
+    scalar::prefix_sum(n - i, x + i, i ? x[i - 1] : T(0));
+}
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+//
+// AVX-512F kernels, the tails are done with masked loads and stores
+//
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f,avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,fma")
+// GCC 12 sees the _mm512_undefined_* placeholders inside its own intrinsics as uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace avx512 {
+
+template <typename T>
+constexpr size_t Width = 64 / sizeof(T);
+
+inline __m512 load(const float* p) { return _mm512_loadu_ps(p); }
+inline __m512d load(const double* p) { return _mm512_loadu_pd(p); }
+// The first count elements, zeros after
+inline __m512 load(const float* p, size_t count) { return _mm512_maskz_loadu_ps(static_cast<__mmask16>((1u << count) - 1), p); }
+inline __m512d load(const double* p, size_t count) { return _mm512_maskz_loadu_pd(static_cast<__mmask8>((1u << count) - 1), p); }
+inline void store(float* p, __m512 v) { _mm512_storeu_ps(p, v); }
+inline void store(double* p, __m512d v) { _mm512_storeu_pd(p, v); }
+inline void store(float* p, __m512 v, size_t count) { _mm512_mask_storeu_ps(p, static_cast<__mmask16>((1u << count) - 1), v); }
+inline void store(double* p, __m512d v, size_t count) { _mm512_mask_storeu_pd(p, static_cast<__mmask8>((1u << count) - 1), v); }
+inline __m512 broadcast(float a) { return _mm512_set1_ps(a); }
+inline __m512d broadcast(double a) { return _mm512_set1_pd(a); }
+inline __m512 add(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
+inline __m512d add(__m512d a, __m512d b) { return _mm512_add_pd(a, b); }
+inline __m512 sub(__m512 a, __m512 b) { return _mm512_sub_ps(a, b); }
+inline __m512d sub(__m512d a, __m512d b) { return _mm512_sub_pd(a, b); }
+inline __m512 mul(__m512 a, __m512 b) { return _mm512_mul_ps(a, b); }
+inline __m512d mul(__m512d a, __m512d b) { return _mm512_mul_pd(a, b); }
+inline __m512 fmadd(__m512 a, __m512 b, __m512 c) { return _mm512_fmadd_ps(a, b, c); }
+inline __m512d fmadd(__m512d a, __m512d b, __m512d c) { return _mm512_fmadd_pd(a, b, c); }
+inline __m512 fmsub(__m512 a, __m512 b, __m512 c) { return _mm512_fmsub_ps(a, b, c); }
+inline __m512d fmsub(__m512d a, __m512d b, __m512d c) { return _mm512_fmsub_pd(a, b, c); }
+inline __m512 abs(__m512 a) { return _mm512_abs_ps(a); }
+inline __m512d abs(__m512d a) { return _mm512_abs_pd(a); }
+inline float horizontal_sum(__m512 v) { return _mm512_reduce_add_ps(v); }
+inline double horizontal_sum(__m512d v) { return _mm512_reduce_add_pd(v); }
+
+// Inclusive scan of the register, log2(Width) steps of shifting in zeros across the whole register
+inline __m512 scan(__m512 v) {
+    auto zero = _mm512_setzero_si512();
+    v = _mm512_add_ps(v, _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(v), zero, 15)));
+    v = _mm512_add_ps(v, _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(v), zero, 14)));
+    v = _mm512_add_ps(v, _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(v), zero, 12)));
+    return _mm512_add_ps(v, _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(v), zero, 8)));
+}
+
+inline __m512d scan(__m512d v) {
+    auto zero = _mm512_setzero_si512();
+    v = _mm512_add_pd(v, _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(v), zero, 7)));
+    v = _mm512_add_pd(v, _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(v), zero, 6)));
+    return _mm512_add_pd(v, _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(v), zero, 4)));
+}
+
+inline __m512 broadcast_last(__m512 v) { return _mm512_permutexvar_ps(_mm512_set1_epi32(15), v); }
+inline __m512d broadcast_last(__m512d v) { return _mm512_permutexvar_pd(_mm512_set1_epi64(7), v); }
+
+template <typename V>
+void two_sum_add(V& s, V& c, V v) {
+    auto t = add(s, v);
+    auto z = sub(t, s);
+    c = add(c, add(sub(s, sub(t, z)), sub(v, z)));
+    s = t;
+}
+
+template <typename T, typename V>
+T finish_compensated(V s, V c) {
+    alignas(64) T lanes[2 * Width<T>];
+    store(lanes, s);
+    store(lanes + Width<T>, c);
+    return scalar::compensated_sum(lanes, 2 * Width<T>);
+}
+
+template <typename T>
+void axpy(size_t n, T a, const T* x, T* y) {
+    constexpr auto W = Width<T>;
+    auto va = broadcast(a);
+    size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+        store(y + i, fmadd(va, load(x + i), load(y + i)));
+        store(y + i + W, fmadd(va, load(x + i + W), load(y + i + W)));
+    }
+    for (; i + W <= n; i += W) store(y + i, fmadd(va, load(x + i), load(y + i)));
+    if (i < n) store(y + i, fmadd(va, load(x + i, n - i), load(y + i, n - i)), n - i);
+}
+
+template <typename T>
+void scal(size_t n, T a, T* x) {
+    constexpr auto W = Width<T>;
+    auto va = broadcast(a);
+    size_t i = 0;
+    for (; i + W <= n; i += W) store(x + i, mul(va, load(x + i)));
+    if (i < n) store(x + i, mul(va, load(x + i, n - i)), n - i);
+}
+
+template <typename T>
+T dot_fast(size_t n, const T* x, const T* y) {
+    constexpr auto W = Width<T>;
+    auto s0 = broadcast(T(0)), s1 = s0, s2 = s0, s3 = s0;
+    size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+        s0 = fmadd(load(x + i), load(y + i), s0);
+        s1 = fmadd(load(x + i + W), load(y + i + W), s1);
+        s2 = fmadd(load(x + i + 2 * W), load(y + i + 2 * W), s2);
+        s3 = fmadd(load(x + i + 3 * W), load(y + i + 3 * W), s3);
+    }
+    for (; i + W <= n; i += W) s0 = fmadd(load(x + i), load(y + i), s0);
+    if (i < n) s1 = fmadd(load(x + i, n - i), load(y + i, n - i), s1);
+    return horizontal_sum(add(add(s0, s1), add(s2, s3)));
+}
+
+template <typename T>
+T dot_compensated(size_t n, const T* x, const T* y) {
+    constexpr auto W = Width<T>;
+    auto s = broadcast(T(0)), c = s;
+    for (size_t i = 0; i < n; i += W) {
+        auto count = std::min(W, n - i);
+        auto vx = count == W ? load(x + i) : load(x + i, count);
+        auto vy = count == W ? load(y + i) : load(y + i, count);
+        auto p = mul(vx, vy);
+        c = add(c, fmsub(vx, vy, p));
+        two_sum_add(s, c, p);
+    }
+    return finish_compensated<T>(s, c);
+}
+
+template <typename T>
+T asum_fast(size_t n, const T* x) {
+    constexpr auto W = Width<T>;
+    auto s0 = broadcast(T(0)), s1 = s0;
+    size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+        s0 = add(s0, abs(load(x + i)));
+        s1 = add(s1, abs(load(x + i + W)));
+    }
+    for (; i + W <= n; i += W) s0 = add(s0, abs(load(x + i)));
+    if (i < n) s1 = add(s1, abs(load(x + i, n - i)));
+    return horizontal_sum(add(s0, s1));
+}
+
+template <typename T>
+T asum_compensated(size_t n, const T* x) {
+    constexpr auto W = Width<T>;
+    auto s = broadcast(T(0)), c = s;
+    for (size_t i = 0; i < n; i += W) {
+        auto count = std::min(W, n - i);
+        two_sum_add(s, c, abs(count == W ? load(x + i) : load(x + i, count)));
+    }
+    return finish_compensated<T>(s, c);
+}
+
+template <typename T>
+void prefix_sum(size_t n, T* x) {
+    constexpr auto W = Width<T>;
+    auto carry = broadcast(T(0));
+    for (size_t i = 0; i < n; i += W) {
+        auto count = std::min(W, n - i);
+        auto v = add(scan(count == W ? load(x + i) : load(x + i, count)), carry);
+        if (count == W) store(x + i, v); else store(x + i, v, count);
+        carry = broadcast_last(v);
+    }
+}
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+#endif // MY_BLAS_X86
+
+}
+
+inline simd_level detected_simd_level() {
+    static const simd_level level = detail::detect_simd_level();
+    return level;
+}
+
+namespace detail {
+
+inline std::atomic<simd_level>& active_simd_level() {
+    static std::atomic<simd_level> level {detected_simd_level()};
+    return level;
+}
+
+// Calls the kernel of the active instruction set: scalar::k, avx2::k or avx512::k
+#ifdef MY_BLAS_X86
+#define MY_BLAS_DISPATCH(kernel, ...) \
+    switch (detail::active_simd_level().load(std::memory_order_relaxed)) { \
+    case simd_level::avx512: return detail::avx512::kernel(__VA_ARGS__); \
+    case simd_level::avx2: return detail::avx2::kernel(__VA_ARGS__); \
+    default: return detail::scalar::kernel(__VA_ARGS__); \
+    }
+#else
+#define MY_BLAS_DISPATCH(kernel, ...) return detail::scalar::kernel(__VA_ARGS__);
+#endif
+
+template <typename T>
+T dot_block(size_t n, const T* x, const T* y, bool compensated) {
+    if (compensated) {
+        MY_BLAS_DISPATCH(dot_compensated, n, x, y)
+    }
+    MY_BLAS_DISPATCH(dot_fast, n, x, y)
+}
+
+template <typename T>
+T asum_block(size_t n, const T* x, bool compensated) {
+    if (compensated) {
+        MY_BLAS_DISPATCH(asum_compensated, n, x)
+    }
+    MY_BLAS_DISPATCH(asum_fast, n, x)
+}
+
+// Sum of block(first, count, compensated) over [first, first + n) as requested by acc
+template <typename T, typename Block>
+T reduce(size_t first, size_t n, accuracy acc, const Block& block) {
+    if (acc == accuracy::compensated && n > PairwiseBlock) {
+        // Over a long vector the error terms pile up in the kernel's own compensation,
+        // so blocks are compensated separately and their results summed the same way
+        T s = 0, c = 0;
+        for (size_t i = 0; i < n; i += PairwiseBlock) {
+            T e;
+            scalar::two_sum(s, block(first + i, std::min(PairwiseBlock, n - i), true), s, e);
+            c += e;
+        }
+        return s + c;
+    }
+    if (acc != accuracy::pairwise || n <= PairwiseBlock) return block(first, n, acc == accuracy::compensated);
+    // Split at a multiple of the block size, so all blocks but the last are full
+    auto half = (n / 2 + PairwiseBlock - 1) / PairwiseBlock * PairwiseBlock;
+    return reduce<T>(first, half, acc, block) + reduce<T>(first + half, n - half, acc, block);
+}
+
+template <typename T>
+void check_sizes(size_t x, size_t y) {
+    static_assert(is_blas_type<T>::value, "the kernels are for float and double");
+    if (x != y) throw std::invalid_argument("vector sizes differ");
+}
+
+}
+
+// Restricts the kernels to level, which the CPU must support. For tests and comparisons
+inline void set_simd_level(simd_level level) {
+    if (level > detected_simd_level()) throw std::invalid_argument("the CPU doesn't support this instruction set");
+    detail::active_simd_level().store(level);
+}
+
+inline simd_level active_simd_level() { return detail::active_simd_level().load(std::memory_order_relaxed); }
+
+// y += a * x
+template <typename T>
+void axpy(detail::no_deduce<T> a, my_span<const T> x, my_span<T> y) {
+    detail::check_sizes<T>(x.size(), y.size());
+    MY_BLAS_DISPATCH(axpy, x.size(), a, x.data(), y.data())
+}
+
+template <typename T>
+void axpy(detail::no_deduce<T> a, const my_vector<T>& x, my_vector<T>& y) {
+    axpy<T>(a, my_span<const T>(x.data(), x.size()), my_span<T>(y.data(), y.size()));
+}
+
+// x *= a
+template <typename T>
+void scal(detail::no_deduce<T> a, my_span<T> x) {
+    detail::check_sizes<T>(x.size(), x.size());
+    MY_BLAS_DISPATCH(scal, x.size(), a, x.data())
+}
+
+template <typename T>
+void scal(detail::no_deduce<T> a, my_vector<T>& x) {
+    scal<T>(a, my_span<T>(x.data(), x.size()));
+}
+
+template <typename T>
+T dot(my_span<const T> x, my_span<const T> y, accuracy acc = accuracy::pairwise) {
+    detail::check_sizes<T>(x.size(), y.size());
+    return detail::reduce<T>(0, x.size(), acc, [&x, &y](size_t first, size_t count, bool compensated) {
+        return detail::dot_block(count, x.data() + first, y.data() + first, compensated);
+    });
+}
+
+template <typename T>
+T dot(const my_vector<T>& x, const my_vector<T>& y, accuracy acc = accuracy::pairwise) {
+    return dot<T>(my_span<const T>(x.data(), x.size()), my_span<const T>(y.data(), y.size()), acc);
+}
+
+// Sum of the magnitudes
+template <typename T>
+T asum(my_span<const T> x, accuracy acc = accuracy::pairwise) {
+    detail::check_sizes<T>(x.size(), x.size());
+    return detail::reduce<T>(0, x.size(), acc, [&x](size_t first, size_t count, bool compensated) {
+        return detail::asum_block(count, x.data() + first, compensated);
+    });
+}
+
+template <typename T>
+T asum(const my_vector<T>& x, accuracy acc = accuracy::pairwise) {
+    return asum<T>(my_span<const T>(x.data(), x.size()), acc);
+}
+
+// Euclidean norm. Computed as sqrt(dot(x, x)), again with scaling by the largest magnitude
+// in the rare case the squares overflow or underflow
+template <typename T>
+T nrm2(my_span<const T> x, accuracy acc = accuracy::pairwise) {
+    auto sum_of_squares = dot<T>(x, x, acc);
+    if (sum_of_squares < std::numeric_limits<T>::infinity() && sum_of_squares >= std::numeric_limits<T>::min()) {
+        return std::sqrt(sum_of_squares);
+    }
+    auto largest = detail::scalar::amax(x.size(), x.data());
+    if (largest == 0 || !std::isfinite(largest)) return largest;
+    auto scaled = detail::scalar::sum_of_scaled_squares(x.size(), x.data(), 1 / largest, acc == accuracy::compensated);
+    return largest * std::sqrt(scaled);
+}
+
+template <typename T>
+T nrm2(const my_vector<T>& x, accuracy acc = accuracy::pairwise) {
+    return nrm2<T>(my_span<const T>(x.data(), x.size()), acc);
+}
+
+// Inclusive prefix sum in place, x[i] = x[0] + ... + x[i].
+// The vector kernels scan whole registers, which adds in another order than the sequential loop;
+// accuracy::compensated runs a sequential Kahan sum instead, pairwise is the same as fast
+template <typename T>
+void prefix_sum(my_span<T> x, accuracy acc = accuracy::fast) {
+    detail::check_sizes<T>(x.size(), x.size());
+    if (acc == accuracy::compensated) {
+        detail::scalar::prefix_sum_compensated(x.size(), x.data());
+        return;
+    }
+    MY_BLAS_DISPATCH(prefix_sum, x.size(), x.data())
+}
+
+template <typename T>
+void prefix_sum(my_vector<T>& x, accuracy acc = accuracy::fast) {
+    prefix_sum<T>(my_span<T>(x.data(), x.size()), acc);
+}
+
+#undef MY_BLAS_DISPATCH
+
+}
+
+}
+
+#endif // MY_BLAS_H
@@ -0,0 +1,124 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_blas.h"
+#include <cmath>
+#include <random>
+
+using namespace cpp_training;
+
+namespace {
+
+template <typename T>
+my_vector<T> random_values(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<T> dist(-1, 1);
+    my_vector<T> result;
+    for (size_t i = 0; i < n; ++i) result.push_back(dist(gen));
+    return result;
+}
+
+// The instruction sets this CPU can run
+my_vector<blas::simd_level> levels() {
+    my_vector<blas::simd_level> result {blas::simd_level::scalar};
+    if (blas::detected_simd_level() >= blas::simd_level::avx2) result.push_back(blas::simd_level::avx2);
+    if (blas::detected_simd_level() >= blas::simd_level::avx512) result.push_back(blas::simd_level::avx512);
+    return result;
+}
+
+template <typename T>
+void check_kernels() {
+    // Every tail length of the vector kernels and a few multiples of the pairwise block
+    my_vector<size_t> sizes;
+    for (size_t n = 0; n <= 70; ++n) sizes.push_back(n);
+    for (size_t n : {1023, 1024, 1025, 5000, 100003}) sizes.push_back(n);
+
+    for (auto level : levels()) {
+        blas::set_simd_level(level);
+        for (auto n : sizes) {
+            auto x = random_values<T>(n, 1);
+            auto y = random_values<T>(n, 2);
+            long double dot = 0, asum = 0, squares = 0;
+            for (size_t i = 0; i < n; ++i) {
+                dot += static_cast<long double>(x[i]) * y[i];
+                asum += std::abs(x[i]);
+                squares += static_cast<long double>(x[i]) * x[i];
+            }
+            auto tolerance = (std::is_same<T, float>::value ? 1e-5 : 1e-13) * (1 + n);
+            for (auto acc : {blas::accuracy::fast, blas::accuracy::pairwise, blas::accuracy::compensated}) {
+                ASSERT_NEAR(blas::dot(x, y, acc), dot, tolerance) << n;
+                ASSERT_NEAR(blas::asum(x, acc), asum, tolerance) << n;
+                ASSERT_NEAR(blas::nrm2(x, acc), std::sqrt(squares), tolerance) << n;
+            }
+
+            auto expected = y;
+            for (size_t i = 0; i < n; ++i) expected[i] = y[i] + T(0.5) * x[i];
+            blas::axpy(0.5, x, y);
+            for (size_t i = 0; i < n; ++i) ASSERT_NEAR(y[i], expected[i], 1e-6) << n;
+
+            blas::scal(-2, y);
+            for (size_t i = 0; i < n; ++i) ASSERT_NEAR(y[i], -2 * expected[i], 1e-6) << n;
+
+            auto scanned = x;
+            blas::prefix_sum(scanned);
+            long double running = 0;
+            for (size_t i = 0; i < n; ++i) {
+                running += x[i];
+                ASSERT_NEAR(scanned[i], running, tolerance) << n << " " << i;
+            }
+        }
+    }
+    blas::set_simd_level(blas::detected_simd_level());
+}
+
+}
+
+TEST(MyBlasTest, FloatKernels) {
+    check_kernels<float>();
+}
+
+TEST(MyBlasTest, DoubleKernels) {
+    check_kernels<double>();
+}
+
+TEST(MyBlasTest, Accuracy) {
+    for (auto level : levels()) {
+        blas::set_simd_level(level);
+        // 0.1f added a million times: the fast sum drifts, pairwise and compensated ones don't
+        my_vector<float> tenths(1000000, 0.1f);
+        my_vector<float> ones(1000000, 1.0f);
+        auto exact = 1000000 * static_cast<double>(0.1f);
+        EXPECT_GT(std::abs(blas::dot(tenths, ones, blas::accuracy::fast) - exact), 1);
+        EXPECT_NEAR(blas::dot(tenths, ones, blas::accuracy::pairwise), exact, 0.5);
+        EXPECT_NEAR(blas::dot(tenths, ones, blas::accuracy::compensated), exact, 1e-2);
+        EXPECT_NEAR(blas::asum(tenths, blas::accuracy::compensated), exact, 1e-2);
+        auto scanned = tenths;
+        blas::prefix_sum(scanned, blas::accuracy::compensated);
+        EXPECT_NEAR(scanned.back(), exact, 1e-2);
+
+        // Cancellation: only the compensated dot product finds the 1
+        my_vector<double> x {1e20, 1, -1e20};
+        my_vector<double> y {1, 1, 1};
+        EXPECT_EQ(blas::dot(x, y, blas::accuracy::compensated), 1);
+
+        // Squares out of range
+        my_vector<double> huge {3e200, 4e200};
+        EXPECT_NEAR(blas::nrm2(huge) / 5e200, 1, 1e-15);
+        my_vector<float> tiny {3e-30f, 4e-30f};
+        EXPECT_NEAR(blas::nrm2(tiny) / 5e-30f, 1, 1e-6);
+        my_vector<double> zeros(10, 0.0);
+        EXPECT_EQ(blas::nrm2(zeros), 0);
+    }
+    blas::set_simd_level(blas::detected_simd_level());
+}
+
+TEST(MyBlasTest, Errors) {
+    my_vector<float> x(3, 1.0f);
+    my_vector<float> y(4, 1.0f);
+    EXPECT_THROW(blas::dot(x, y), std::invalid_argument);
+    EXPECT_THROW(blas::axpy(1, x, y), std::invalid_argument);
+    EXPECT_EQ(blas::active_simd_level(), blas::detected_simd_level());
+    if (blas::detected_simd_level() != blas::simd_level::avx512) {
+        EXPECT_THROW(blas::set_simd_level(blas::simd_level::avx512), std::invalid_argument);
+    }
+}
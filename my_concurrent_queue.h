@@ -0,0 +1,312 @@
+#ifndef MY_CONCURRENT_QUEUE_H
+#define MY_CONCURRENT_QUEUE_H
+
+#include <atomic>
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_parallel.h"
+
+namespace cpp_training {
+
+namespace detail {
+
+inline size_t queue_capacity(size_t capacity, size_t min_capacity) {
+    size_t result = min_capacity;
+    while (result < capacity) result <<= 1;
+    return result;
+}
+
+}
+
+// Bounded lock-free single producer, single consumer queue.
+// Slots are preallocated in a my_vector, head and tail live on separate cache lines,
+// and each side caches the position of the other one to avoid touching its cache line on every operation.
+// Batch operations publish the whole batch with a single atomic store.
+template <typename T>
+class my_spsc_queue {
+    using slot_type = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    using value_type = T;
+
+    // The capacity is rounded up to a power of two
+    explicit my_spsc_queue(size_t capacity) {
+        auto cap = detail::queue_capacity(capacity, 1);
+        m_slots.reserve(cap);
+        m_slots.resize(cap);
+        m_mask = cap - 1;
+    }
+
+    my_spsc_queue(const my_spsc_queue&) = delete;
+    my_spsc_queue& operator = (const my_spsc_queue&) = delete;
+
+    ~my_spsc_queue() {
+        for (auto pos = m_head.load(); pos != m_tail.load(); ++pos) {
+            slot(pos)->~T();
+        }
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // Approximate when called concurrently
+    size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    //
+    // Producer side
+    //
+
+    bool try_push(const T& value) { return try_emplace(value); }
+
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    template< class... Args >
+    bool try_emplace( Args&&... args ) {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head == capacity()) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail - m_cached_head == capacity()) return false;
+        }
+        new (&m_slots[tail & m_mask]) T{ std::forward<Args>(args)... };
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Copies as many of items [0, count) as fit, returns their number.
+    // If a copy throws, the items copied before it are pushed
+    size_t try_push_n(const T* items, size_t count) {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        if (capacity() - (tail - m_cached_head) < count) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+        }
+        auto n = std::min(count, capacity() - (tail - m_cached_head));
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                new (&m_slots[(tail + i) & m_mask]) T{ items[i] };
+            }
+        } catch (...) {
+            m_tail.store(tail + i, std::memory_order_release);
+            throw;
+        }
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    size_t try_push_n(const my_vector<T>& items) {
+        return try_push_n(items.data(), items.size());
+    }
+
+    //
+    // Consumer side
+    //
+
+    bool try_pop(T& value) {
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cached_tail) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail) return false;
+        }
+        auto item_p = slot(head);
+        value = std::move(*item_p);
+        item_p->~T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Moves up to max_count items to the end of out, returns their number.
+    // If a move throws, the items moved before it are popped and the others stay in the queue
+    size_t try_pop_n(my_vector<T>& out, size_t max_count) {
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (m_cached_tail - head < max_count) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+        }
+        auto n = std::min(max_count, m_cached_tail - head);
+        out.reserve(out.size() + n);
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                auto item_p = slot(head + i);
+                out.push_back(std::move(*item_p));
+                item_p->~T();
+            }
+        } catch (...) {
+            m_head.store(head + i, std::memory_order_release);
+            throw;
+        }
+        m_head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+private:
+    T* slot(size_t pos) {
+        return std::launder(reinterpret_cast<T*>(&m_slots[pos & m_mask]));
+    }
+
+private:
+    my_vector<slot_type> m_slots;
+    size_t m_mask = 0;
+
+    // Consumer cache line
+    alignas(CacheLineSize) std::atomic<size_t> m_head {0};
+    size_t m_cached_tail = 0;
+
+    // Producer cache line
+    alignas(CacheLineSize) std::atomic<size_t> m_tail {0};
+    size_t m_cached_head = 0;
+};
+
+// Bounded lock-free multi producer, multi consumer queue (D. Vyukov's algorithm).
+// Every slot carries a sequence number telling whether it is ready to be written or read in the current lap,
+// so producers and consumers only contend on the position they claim with a CAS.
+// Slots are cache line padded to avoid false sharing between neighbouring operations.
+template <typename T>
+class my_mpmc_queue {
+    struct alignas(CacheLineSize) cell {
+        std::atomic<size_t> sequence;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+    using cell_storage = std::aligned_storage_t<sizeof(cell), alignof(cell)>;
+
+public:
+    using value_type = T;
+
+    // The capacity is rounded up to a power of two, at least 2
+    explicit my_mpmc_queue(size_t capacity) {
+        auto cap = detail::queue_capacity(capacity, 2);
+        m_cells.reserve(cap);
+        m_cells.resize(cap);
+        m_mask = cap - 1;
+        for (size_t i = 0; i < cap; ++i) {
+            new (&m_cells[i]) cell;
+            cell_at(i)->sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    my_mpmc_queue(const my_mpmc_queue&) = delete;
+    my_mpmc_queue& operator = (const my_mpmc_queue&) = delete;
+
+    ~my_mpmc_queue() {
+        while (try_consume([](T&&) {})) {}
+        for (size_t i = 0; i < capacity(); ++i) {
+            cell_at(i)->~cell();
+        }
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    // A claimed slot must be published, so T is constructed in the slot only when that can't throw.
+    // Otherwise the item is built first and moved in, and rvalue args may be moved from even if the queue is full
+    template< class... Args >
+    bool try_emplace( Args&&... args ) {
+        if constexpr (std::is_nothrow_constructible<T, Args&&...>::value) {
+            return try_emplace_nothrow(std::forward<Args>(args)...);
+        } else {
+            static_assert(std::is_nothrow_move_constructible<T>::value, "my_mpmc_queue needs a noexcept move constructor");
+            T item{ std::forward<Args>(args)... };
+            return try_emplace_nothrow(std::move(item));
+        }
+    }
+
+    bool try_pop(T& value) {
+        return try_consume([&value](T&& item) { value = std::move(item); });
+    }
+
+    // Copies items [0, count) until the queue is full, returns the number pushed.
+    // Each item claims its own slot, so a batch may interleave with other producers.
+    size_t try_push_n(const T* items, size_t count) {
+        size_t n = 0;
+        while (n < count && try_emplace(items[n])) ++n;
+        return n;
+    }
+
+    size_t try_push_n(const my_vector<T>& items) {
+        return try_push_n(items.data(), items.size());
+    }
+
+    // Moves up to max_count items to the end of out, returns their number
+    size_t try_pop_n(my_vector<T>& out, size_t max_count) {
+        size_t n = 0;
+        while (n < max_count && try_consume([&out](T&& item) { out.push_back(std::move(item)); })) {
+            ++n;
+        }
+        return n;
+    }
+
+private:
+    template< class... Args >
+    bool try_emplace_nothrow( Args&&... args ) {
+        auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        cell* cell_p;
+        for (;;) {
+            cell_p = cell_at(pos);
+            auto seq = cell_p->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Full
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        new (&cell_p->storage) T{ std::forward<Args>(args)... };
+        cell_p->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Claims the next readable slot and hands its item to consume(T&&)
+    template <typename Consume>
+    bool try_consume(Consume&& consume) {
+        auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        cell* cell_p;
+        for (;;) {
+            cell_p = cell_at(pos);
+            auto seq = cell_p->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;   // Empty
+            } else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        auto item_p = std::launder(reinterpret_cast<T*>(&cell_p->storage));
+        // Release the slot even if consume throws, the item is lost then
+        struct slot_release {
+            cell* cell_p;
+            T* item_p;
+            size_t sequence;
+            ~slot_release() {
+                item_p->~T();
+                cell_p->sequence.store(sequence, std::memory_order_release);
+            }
+        } release {cell_p, item_p, pos + m_mask + 1};
+        consume(std::move(*item_p));
+        return true;
+    }
+
+    cell* cell_at(size_t pos) {
+        return std::launder(reinterpret_cast<cell*>(&m_cells[pos & m_mask]));
+    }
+
+private:
+    my_vector<cell_storage> m_cells;
+    size_t m_mask = 0;
+    alignas(CacheLineSize) std::atomic<size_t> m_enqueue_pos {0};
+    alignas(CacheLineSize) std::atomic<size_t> m_dequeue_pos {0};
+};
+
+}
+
+#endif // MY_CONCURRENT_QUEUE_H
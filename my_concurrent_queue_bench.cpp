@@ -0,0 +1,169 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// Throughput and mean latency of my_spsc_queue / my_mpmc_queue vs a mutex + condition variable queue,
+// 1 producer 1 consumer and 8 producers 8 consumers, item by item and in batches of try_push_n / try_pop_n.
+// Items carry their enqueue timestamp.
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "my_concurrent_queue.h"
+#include "my_ring_buffer.h"
+
+using namespace cpp_training;
+
+namespace {
+
+constexpr size_t Capacity = 1024;
+constexpr uint64_t ItemsPerProducer = 1000000;
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The baseline, a bounded blocking queue
+class locked_queue {
+public:
+    void push(uint64_t value) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [this] { return m_items.size() < Capacity; });
+        m_items.push_back(value);
+        m_not_empty.notify_one();
+    }
+
+    uint64_t pop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this] { return !m_items.is_empty(); });
+        auto value = m_items.front();
+        m_items.pop_front();
+        m_not_full.notify_one();
+        return value;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty, m_not_full;
+    my_ring_buffer<uint64_t> m_items {Capacity};
+};
+
+template <typename Push, typename Pop>
+void run(const char* name, int producers, int consumers, Push push, Pop pop) {
+    std::atomic<uint64_t> latency_sum {0};
+    std::vector<std::thread> threads;
+    const uint64_t total = ItemsPerProducer * producers;
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            for (uint64_t i = 0; i < ItemsPerProducer; ++i) push(now_ns());
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        // Consumers split the items evenly, the first one takes the remainder
+        auto share = total / consumers + (c == 0 ? total % consumers : 0);
+        threads.emplace_back([&, share] {
+            uint64_t local = 0;
+            for (uint64_t i = 0; i < share; ++i) {
+                auto sent = pop();
+                local += now_ns() - sent;
+            }
+            latency_sum += local;
+        });
+    }
+    for (auto& th : threads) th.join();
+    auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::setw(22) << name << std::setw(6) << producers << "P" << consumers << "C"
+              << std::setw(16) << std::fixed << std::setprecision(0) << total / secs
+              << std::setw(14) << latency_sum.load() / total << std::endl;
+}
+
+// Producers push batches of Batch timestamps with try_push_n, consumers take up to Batch at a time with try_pop_n
+template <typename Queue>
+void run_batched(const char* name, int producers, int consumers, Queue& queue) {
+    constexpr size_t Batch = 64;
+    std::atomic<uint64_t> latency_sum {0};
+    std::vector<std::thread> threads;
+    const uint64_t total = ItemsPerProducer * producers;
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            my_vector<uint64_t> batch;
+            for (uint64_t sent = 0; sent < ItemsPerProducer;) {
+                batch.clear();
+                auto stamp = now_ns();
+                for (size_t i = 0; i < Batch && sent + i < ItemsPerProducer; ++i) batch.push_back(stamp);
+                for (size_t pushed = 0; pushed < batch.size();) {
+                    auto n = queue.try_push_n(batch.data() + pushed, batch.size() - pushed);
+                    if (n == 0) std::this_thread::yield();
+                    pushed += n;
+                }
+                sent += batch.size();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        auto share = total / consumers + (c == 0 ? total % consumers : 0);
+        threads.emplace_back([&, share] {
+            uint64_t local = 0;
+            my_vector<uint64_t> items;
+            for (uint64_t received = 0; received < share;) {
+                items.clear();
+                if (queue.try_pop_n(items, std::min<uint64_t>(Batch, share - received)) == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                auto now = now_ns();
+                for (auto sent : items) local += now - sent;
+                received += items.size();
+            }
+            latency_sum += local;
+        });
+    }
+    for (auto& th : threads) th.join();
+    auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::setw(22) << name << std::setw(6) << producers << "P" << consumers << "C"
+              << std::setw(16) << std::fixed << std::setprecision(0) << total / secs
+              << std::setw(14) << latency_sum.load() / total << std::endl;
+}
+
+}
+
+int main() {
+    std::cout << std::setw(22) << "queue" << std::setw(8) << "load" << std::setw(16) << "items/s"
+              << std::setw(14) << "latency ns" << std::endl;
+
+    for (int threads : {1, 8}) {
+        {
+            locked_queue queue;
+            run("mutex+condvar", threads, threads,
+                [&](uint64_t v) { queue.push(v); },
+                [&] { return queue.pop(); });
+        }
+        if (threads == 1) {
+            my_spsc_queue<uint64_t> queue(Capacity);
+            run("my_spsc_queue", 1, 1,
+                [&](uint64_t v) { while (!queue.try_push(v)) std::this_thread::yield(); },
+                [&] { uint64_t v; while (!queue.try_pop(v)) std::this_thread::yield(); return v; });
+        }
+        {
+            my_mpmc_queue<uint64_t> queue(Capacity);
+            run("my_mpmc_queue", threads, threads,
+                [&](uint64_t v) { while (!queue.try_push(v)) std::this_thread::yield(); },
+                [&] { uint64_t v; while (!queue.try_pop(v)) std::this_thread::yield(); return v; });
+        }
+        if (threads == 1) {
+            my_spsc_queue<uint64_t> queue(Capacity);
+            run_batched("my_spsc_queue batch", 1, 1, queue);
+        }
+        {
+            my_mpmc_queue<uint64_t> queue(Capacity);
+            run_batched("my_mpmc_queue batch", threads, threads, queue);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_concurrent_queue.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cpp_training;
+
+TEST(MySpscQueueTest, PushPop) {
+    my_spsc_queue<std::string> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+
+    std::string out;
+    EXPECT_FALSE(queue.try_pop(out));
+    EXPECT_TRUE(queue.try_push("a"));
+    EXPECT_TRUE(queue.try_emplace("b"));
+    EXPECT_EQ(queue.size(), 2);
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out, "a");
+
+    my_vector<std::string> batch {"c", "d", "e", "f"};
+    EXPECT_EQ(queue.try_push_n(batch), 3);
+    EXPECT_FALSE(queue.try_push("g"));
+
+    my_vector<std::string> popped;
+    EXPECT_EQ(queue.try_pop_n(popped, 10), 4);
+    EXPECT_EQ(popped, (my_vector<std::string>{"b", "c", "d", "e"}));
+    EXPECT_EQ(queue.try_pop_n(popped, 10), 0);
+
+    // Remaining items are destroyed with the queue
+    queue.try_push("left over");
+}
+
+namespace {
+// Copies and moves throw once the budget is spent, the destructor catches double destruction
+struct FragileItem {
+    static constexpr int Alive = 0x600d;
+    static int budget;
+    static int live;
+    int state = Alive;
+    int value;
+    explicit FragileItem(int v) : value(v) { ++live; }
+    FragileItem(const FragileItem& rhs) : value(rhs.value) { spend(); ++live; }
+    FragileItem(FragileItem&& rhs) : value(rhs.value) { spend(); ++live; }
+    ~FragileItem() {
+        EXPECT_EQ(state, Alive);
+        state = 0;
+        --live;
+    }
+    static void spend() {
+        if (budget-- <= 0) throw std::runtime_error("out of budget");
+    }
+};
+int FragileItem::budget = 0;
+int FragileItem::live = 0;
+}
+
+TEST(MySpscQueueTest, ThrowingBatches) {
+    {
+        my_spsc_queue<FragileItem> queue(8);
+        const FragileItem items[] {FragileItem(1), FragileItem(2), FragileItem(3), FragileItem(4)};
+        FragileItem::budget = 2;
+        EXPECT_THROW(queue.try_push_n(items, 4), std::runtime_error);
+        EXPECT_EQ(queue.size(), 2);
+
+        my_vector<FragileItem> out;
+        FragileItem::budget = 1;
+        EXPECT_THROW(queue.try_pop_n(out, 8), std::runtime_error);
+        EXPECT_EQ(out.size(), 1);
+        EXPECT_EQ(out[0].value, 1);
+        EXPECT_EQ(queue.size(), 1);
+
+        FragileItem::budget = 100;
+        out.clear();
+        out.reserve(8);
+        EXPECT_EQ(queue.try_pop_n(out, 8), 1);
+        EXPECT_EQ(out[0].value, 2);
+        EXPECT_EQ(queue.try_push_n(items, 4), 4);
+    }
+    EXPECT_EQ(FragileItem::live, 0);
+}
+
+TEST(MySpscQueueTest, ProducerConsumer) {
+    const int count = 200000;
+    my_spsc_queue<int> queue(256);
+    std::thread producer([&] {
+        my_vector<int> batch;
+        int next = 0;
+        while (next < count) {
+            if (next % 3 == 0) {
+                while (!queue.try_push(next)) std::this_thread::yield();
+                ++next;
+            } else {
+                batch.clear();
+                for (int i = next; i < std::min(next + 17, count); ++i) batch.push_back(i);
+                next += queue.try_push_n(batch);
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 0;
+    bool ordered = true;
+    my_vector<int> out;
+    while (expected < count) {
+        out.clear();
+        if (queue.try_pop_n(out, 32) == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (auto v : out) ordered = ordered && v == expected++;
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+}
+
+TEST(MyMpmcQueueTest, PushPop) {
+    my_mpmc_queue<std::string> queue(1);
+    EXPECT_EQ(queue.capacity(), 2);
+
+    std::string out;
+    EXPECT_FALSE(queue.try_pop(out));
+    EXPECT_TRUE(queue.try_push("a"));
+    EXPECT_TRUE(queue.try_push("b"));
+    EXPECT_FALSE(queue.try_push("c"));
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out, "a");
+
+    my_vector<std::string> batch {"c", "d"};
+    EXPECT_EQ(queue.try_push_n(batch), 1);
+    my_vector<std::string> popped;
+    EXPECT_EQ(queue.try_pop_n(popped, 5), 2);
+    EXPECT_EQ(popped, (my_vector<std::string>{"b", "c"}));
+
+    queue.try_push("left over");
+}
+
+namespace {
+struct ThrowingItem {
+    int value;
+    explicit ThrowingItem(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("negative");
+    }
+};
+}
+
+TEST(MyMpmcQueueTest, ThrowingConstructor) {
+    // A constructor throwing must not leave a claimed, never published slot behind
+    my_mpmc_queue<ThrowingItem> queue(2);
+    EXPECT_THROW(queue.try_emplace(-1), std::runtime_error);
+    EXPECT_TRUE(queue.try_emplace(1));
+    EXPECT_TRUE(queue.try_emplace(2));
+    EXPECT_FALSE(queue.try_emplace(3));
+    ThrowingItem out(0);
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out.value, 1);
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out.value, 2);
+    EXPECT_FALSE(queue.try_pop(out));
+}
+
+TEST(MyMpmcQueueTest, ManyProducersConsumers) {
+    const int producers = 4, consumers = 4, per_producer = 50000;
+    my_mpmc_queue<long> queue(128);
+    std::atomic<long> sum {0};
+    std::atomic<int> consumed {0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (long i = 1; i <= per_producer; ++i) {
+                while (!queue.try_push(i + p * per_producer)) std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            my_vector<long> out;
+            while (consumed.load() < producers * per_producer) {
+                out.clear();
+                auto n = queue.try_pop_n(out, 16);
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (auto v : out) sum += v;
+                consumed += static_cast<int>(n);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    long total = static_cast<long>(producers) * per_producer;
+    EXPECT_EQ(consumed.load(), total);
+    EXPECT_EQ(sum.load(), total * (total + 1) / 2);
+}
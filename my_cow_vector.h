@@ -0,0 +1,229 @@
+#ifndef MY_COW_VECTOR_H
+#define MY_COW_VECTOR_H
+
+#include <atomic>
+#include <utility>
+#include <initializer_list>
+#include <stdexcept>
+#include "my_vector.h"
+
+namespace cpp_training {
+
+// Copy-on-write vector.
+// Copies share one reference counted my_vector, so copying is O(1). The storage is copied
+// on the first mutation of a shared instance, so every copy behaves like an independent snapshot.
+//
+// Thread safety is the same as for std::shared_ptr: different instances sharing the storage may be
+// read, copied, mutated and destroyed concurrently, a single instance must not be mutated concurrently.
+// Read access is const only, mutation goes through explicit members which detach shared storage first.
+template <typename T>
+class my_cow_vector {
+    struct shared_block {
+        explicit shared_block(my_vector<T>&& v) : data(std::move(v)) {}
+        explicit shared_block(const my_vector<T>& v) : data(v) {}
+
+        std::atomic<size_t> refs {1};
+        my_vector<T> data;
+    };
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using const_iterator = typename my_vector<T>::const_iterator;
+    using const_reverse_iterator = typename my_vector<T>::const_reverse_iterator;
+
+public:
+
+    my_cow_vector() {
+    }
+
+    explicit my_cow_vector(size_t size, const T& init_value = T())
+        : m_block_p(new shared_block(my_vector<T>(size, init_value))) {
+    }
+
+    my_cow_vector(std::initializer_list<T> lst)
+        : m_block_p(new shared_block(my_vector<T>(lst))) {
+    }
+
+    // Takes ownership of the vector content
+    explicit my_cow_vector(my_vector<T>&& vec)
+        : m_block_p(new shared_block(std::move(vec))) {
+    }
+
+    explicit my_cow_vector(const my_vector<T>& vec)
+        : m_block_p(new shared_block(vec)) {
+    }
+
+    my_cow_vector(const my_cow_vector& rhs) noexcept : m_block_p(rhs.m_block_p) {
+        if (m_block_p) m_block_p->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    my_cow_vector(my_cow_vector&& rhs) noexcept : m_block_p(rhs.m_block_p) {
+        rhs.m_block_p = nullptr;
+    }
+
+    ~my_cow_vector() noexcept {
+        release();
+    }
+
+    my_cow_vector& operator = (const my_cow_vector& rhs) noexcept {
+        my_cow_vector tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_cow_vector& operator = (my_cow_vector&& rhs) noexcept {
+        if (this == &rhs) return *this;
+        release();
+        m_block_p = rhs.m_block_p;
+        rhs.m_block_p = nullptr;
+        return *this;
+    }
+
+    void swap(my_cow_vector& rhs) noexcept {
+        std::swap(m_block_p, rhs.m_block_p);
+    }
+
+    //
+    // Read access, never copies
+    //
+
+    size_t size() const {
+        return m_block_p ? m_block_p->data.size() : 0;
+    }
+
+    bool is_empty() const {
+        return size() == 0;
+    }
+
+    const T& operator [] (size_t i) const {
+        return m_block_p->data[i];
+    }
+
+    const T& at (size_t pos) const {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        return m_block_p->data[pos];
+    }
+
+    const T& front() const {
+        return m_block_p->data.front();
+    }
+
+    const T& back() const {
+        return m_block_p->data.back();
+    }
+
+    const_iterator begin() const noexcept { return view().begin(); }
+
+    const_iterator end() const noexcept { return view().end(); }
+
+    const_iterator cbegin() const noexcept { return view().cbegin(); }
+
+    const_iterator cend() const noexcept { return view().cend(); }
+
+    const_reverse_iterator rcbegin() const noexcept { return view().rcbegin(); }
+
+    const_reverse_iterator rcend() const noexcept { return view().rcend(); }
+
+    // The underlying vector, valid until this instance is mutated or destroyed
+    const my_vector<T>& view() const noexcept {
+        return m_block_p ? m_block_p->data : empty_vector();
+    }
+
+    // Number of instances sharing the storage, 0 for an empty default constructed vector
+    size_t use_count() const noexcept {
+        return m_block_p ? m_block_p->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    bool is_shared() const noexcept {
+        return use_count() > 1;
+    }
+
+    //
+    // Mutation, copies the storage first if it is shared
+    //
+
+    // Calls fn(my_vector<T>&) for in-place modification of unique storage, returns what fn returns.
+    // The vector must not be used once fn returns: a copy taken later would share it with this instance
+    template <typename Fn>
+    decltype(auto) modify(Fn&& fn) {
+        return std::forward<Fn>(fn)(mutate());
+    }
+
+    void set(size_t pos, const T& value) {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        mutate()[pos] = value;
+    }
+
+    void set(size_t pos, T&& value) {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        mutate()[pos] = std::move(value);
+    }
+
+    void push_back(const T& value) {
+        mutate().push_back(value);
+    }
+
+    void push_back(T&& value) {
+        mutate().push_back(std::move(value));
+    }
+
+    template< class... Args >
+    void emplace_back( Args&&... args ) {
+        mutate().emplace_back(std::forward<Args>(args)...);
+    }
+
+    void pop_back() {
+        if (!is_empty()) mutate().pop_back();
+    }
+
+    void resize(size_t count, const T& value = T()) {
+        mutate().resize(count, value);
+    }
+
+    // Drops the reference to the storage, other snapshots are not affected
+    void clear() noexcept {
+        release();
+    }
+
+    bool operator == (const my_cow_vector& rhs) const {
+        return m_block_p == rhs.m_block_p || view() == rhs.view();
+    }
+
+    bool operator != (const my_cow_vector& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    // The underlying vector made unique, valid until the next copy of this instance
+    my_vector<T>& mutate() {
+        if (!m_block_p) {
+            m_block_p = new shared_block(my_vector<T>());
+        } else if (m_block_p->refs.load(std::memory_order_acquire) != 1) {
+            auto copy_p = new shared_block(m_block_p->data);
+            release();
+            m_block_p = copy_p;
+        }
+        return m_block_p->data;
+    }
+
+    void release() noexcept {
+        if (m_block_p && m_block_p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete m_block_p;
+        }
+        m_block_p = nullptr;
+    }
+
+    static const my_vector<T>& empty_vector() noexcept {
+        static const my_vector<T> empty;
+        return empty;
+    }
+
+private:
+    shared_block * m_block_p = nullptr;
+};
+
+}
+
+#endif // MY_COW_VECTOR_H
@@ -0,0 +1,118 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_cow_vector.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cpp_training;
+
+TEST(MyCowVectorTest, Construction) {
+    my_cow_vector<int> empty;
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_EQ(empty.use_count(), 0);
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_THROW(empty.at(0), std::out_of_range);
+
+    my_cow_vector<int> vec {1, 2, 3};
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec.at(2), 3);
+    EXPECT_EQ(vec.use_count(), 1);
+
+    my_vector<std::string> src {"a", "b"};
+    my_cow_vector<std::string> strs(std::move(src));
+    EXPECT_EQ(src.size(), 0);
+    EXPECT_EQ(strs.size(), 2);
+    EXPECT_EQ(strs.back(), "b");
+
+    my_cow_vector<std::string> filled(3, "x");
+    EXPECT_EQ(filled.view(), (my_vector<std::string>{"x", "x", "x"}));
+}
+
+TEST(MyCowVectorTest, CopyShares) {
+    my_cow_vector<int> vec {1, 2, 3};
+    my_cow_vector<int> copy = vec;
+    EXPECT_EQ(vec.use_count(), 2);
+    EXPECT_TRUE(copy.is_shared());
+    EXPECT_EQ(&vec[0], &copy[0]);
+    EXPECT_EQ(vec, copy);
+
+    my_cow_vector<int> moved = std::move(copy);
+    EXPECT_EQ(copy.size(), 0);
+    EXPECT_EQ(vec.use_count(), 2);
+
+    moved = vec;
+    EXPECT_EQ(vec.use_count(), 2);
+    moved.clear();
+    EXPECT_EQ(vec.use_count(), 1);
+}
+
+TEST(MyCowVectorTest, CopyOnWrite) {
+    my_cow_vector<std::string> vec {"hello", "world"};
+    my_cow_vector<std::string> snapshot = vec;
+
+    vec.set(1, "there");
+    EXPECT_EQ(vec[1], "there");
+    EXPECT_EQ(snapshot[1], "world");
+    EXPECT_EQ(vec.use_count(), 1);
+    EXPECT_EQ(snapshot.use_count(), 1);
+
+    // Unique storage is modified in place
+    const std::string* addr = &vec[0];
+    vec.set(0, "hi");
+    EXPECT_EQ(&vec[0], addr);
+    vec.push_back("!");
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[0], "hi");
+
+    my_cow_vector<std::string> snapshot2 = vec;
+    vec.pop_back();
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(snapshot2.size(), 3);
+
+    vec.modify([](my_vector<std::string>& v) { v.push_back("x"); });
+    vec.emplace_back("yy");
+    EXPECT_EQ(vec.view(), (my_vector<std::string>{"hi", "there", "x", "yy"}));
+    EXPECT_EQ(snapshot2.view(), (my_vector<std::string>{"hi", "there", "!"}));
+    EXPECT_EQ(snapshot.view(), (my_vector<std::string>{"hello", "world"}));
+
+    // Modifying after a copy detaches again
+    auto snapshot3 = vec;
+    auto size = vec.modify([](my_vector<std::string>& v) { v[0] = "bye"; return v.size(); });
+    EXPECT_EQ(size, 4);
+    EXPECT_EQ(vec[0], "bye");
+    EXPECT_EQ(snapshot3[0], "hi");
+
+    EXPECT_THROW(vec.set(10, "z"), std::out_of_range);
+
+    my_cow_vector<int> empty;
+    empty.push_back(5);
+    EXPECT_EQ(empty.size(), 1);
+    empty.resize(3, 1);
+    EXPECT_EQ(empty.view(), (my_vector<int>{5, 1, 1}));
+}
+
+TEST(MyCowVectorTest, ConcurrentSnapshots) {
+    my_cow_vector<int> table(1000, 1);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([table, t] () mutable {
+            for (int iter = 0; iter < 100; ++iter) {
+                my_cow_vector<int> snapshot = table;
+                long sum = 0;
+                for (auto v : snapshot) sum += v;
+                EXPECT_EQ(sum, iter > 50 ? 999 + t : 1000);
+                if (iter == 50) {
+                    // Mutating a private copy must not affect other threads
+                    table.set(0, t);
+                }
+            }
+        });
+    }
+    for (auto& th : readers) th.join();
+    EXPECT_EQ(table.use_count(), 1);
+    EXPECT_EQ(table[0], 1);
+}
@@ -0,0 +1,322 @@
+#ifndef MY_DEVECTOR_H
+#define MY_DEVECTOR_H
+
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_span.h"
+
+// Interface after boost::container::devector : https://www.boost.org/doc/libs/release/doc/html/container/non_standard_containers.html#container.non_standard_containers.devector
+
+namespace cpp_training {
+
+// Contiguous sequence with free capacity at both ends of its buffer, a my_vector of raw slots.
+// The content is [front_free_capacity(), front_free_capacity() + size()), so push_front and
+// pop_front are amortized O(1) like push_back while data() stays one array.
+// When an end runs out of room the content is recentered in place if at least as many slots are free
+// as are in use, otherwise moved into a buffer twice as large; either way the end gets half of the free slots.
+// Inserting or erasing in the middle shifts the shorter side.
+template <typename T>
+class my_devector {
+    using slot_type = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    static constexpr size_t MinCapacity = 16;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+public:
+
+    my_devector() {
+    }
+
+    my_devector(std::initializer_list<T> lst) {
+        reserve(lst.size());
+        for (auto& v : lst) emplace_back(v);
+    }
+
+    explicit my_devector(const my_vector<T>& values) {
+        reserve(values.size());
+        for (size_t i = 0; i < values.size(); ++i) emplace_back(values[i]);
+    }
+
+    my_devector(const my_devector& rhs) {
+        reserve(rhs.size());
+        for (auto& v : rhs) emplace_back(v);
+    }
+
+    my_devector(my_devector&& rhs) noexcept
+        : m_slots(std::move(rhs.m_slots)), m_begin(rhs.m_begin), m_end(rhs.m_end) {
+        rhs.m_begin = 0;
+        rhs.m_end = 0;
+    }
+
+    ~my_devector() noexcept {
+        clear();
+    }
+
+    my_devector& operator = (const my_devector& rhs) {
+        my_devector tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_devector& operator = (my_devector&& rhs) noexcept {
+        my_devector tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(my_devector& rhs) noexcept {
+        m_slots.swap(rhs.m_slots);
+        std::swap(m_begin, rhs.m_begin);
+        std::swap(m_end, rhs.m_end);
+    }
+
+    size_t size() const { return m_end - m_begin; }
+
+    size_t capacity() const { return m_slots.size(); }
+
+    bool is_empty() const { return m_begin == m_end; }
+
+    // Number of push_front calls possible without moving anything
+    size_t front_free_capacity() const { return m_begin; }
+
+    // Number of push_back calls possible without moving anything
+    size_t back_free_capacity() const { return capacity() - m_end; }
+
+    // Makes room for new_cap - size() push_back calls
+    void reserve(size_t new_cap) {
+        if (new_cap > size()) reserve_back(new_cap - size());
+    }
+
+    void reserve_front(size_t count) {
+        if (front_free_capacity() < count) make_room_front(count);
+    }
+
+    void reserve_back(size_t count) {
+        if (back_free_capacity() < count) make_room_back(count);
+    }
+
+    T& operator [] (size_t i) { return *slot(m_begin + i); }
+
+    const T& operator [] (size_t i) const { return *slot(m_begin + i); }
+
+    T& at (size_t pos) {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        return (*this)[pos];
+    }
+
+    const T& at (size_t pos) const {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        return (*this)[pos];
+    }
+
+    T& front() { return (*this)[0]; }
+
+    const T& front() const { return (*this)[0]; }
+
+    T& back() { return (*this)[size() - 1]; }
+
+    const T& back() const { return (*this)[size() - 1]; }
+
+    T* data() noexcept { return base() + m_begin; }
+
+    const T* data() const noexcept { return base() + m_begin; }
+
+    my_span<T> as_span() { return my_span<T>(data(), size()); }
+
+    my_span<const T> as_span() const { return my_span<const T>(data(), size()); }
+
+    // args must not refer to an element of the devector
+    template< class... Args >
+    T& emplace_front(Args&&... args) {
+        reserve_front(1);
+        auto p = new (&m_slots[m_begin - 1]) T{ std::forward<Args>(args)... };
+        --m_begin;
+        return *p;
+    }
+
+    // args must not refer to an element of the devector
+    template< class... Args >
+    T& emplace_back(Args&&... args) {
+        reserve_back(1);
+        auto p = new (&m_slots[m_end]) T{ std::forward<Args>(args)... };
+        ++m_end;
+        return *p;
+    }
+
+    // value may be an element of the devector
+    void push_front(const T& value) {
+        if (m_begin == 0) {
+            T copy{ value };
+            emplace_front(std::move(copy));
+        } else {
+            emplace_front(value);
+        }
+    }
+
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    void push_back(const T& value) {
+        if (m_end == capacity()) {
+            T copy{ value };
+            emplace_back(std::move(copy));
+        } else {
+            emplace_back(value);
+        }
+    }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_front() {
+        if (is_empty()) return;
+        slot(m_begin)->~T();
+        ++m_begin;
+    }
+
+    void pop_back() {
+        if (is_empty()) return;
+        --m_end;
+        slot(m_end)->~T();
+    }
+
+    // Inserts before pos, shifting the elements on the shorter side of pos by one
+    template< class... Args >
+    T& emplace(size_t pos, Args&&... args) {
+        if (pos > size()) throw std::out_of_range("pos is out of range");
+        if (pos == 0) return emplace_front(std::forward<Args>(args)...);
+        if (pos == size()) return emplace_back(std::forward<Args>(args)...);
+        // Built first, the arguments may refer to an element which is about to move
+        T value{ std::forward<Args>(args)... };
+        size_t target;
+        if (pos < size() / 2) {
+            reserve_front(1);
+            --m_begin;
+            for (size_t i = m_begin; i < m_begin + pos; ++i) relocate(i + 1, i);
+            target = m_begin + pos;
+        } else {
+            reserve_back(1);
+            for (size_t i = m_end; i > m_begin + pos; --i) relocate(i - 1, i);
+            ++m_end;
+            target = m_begin + pos;
+        }
+        return *new (&m_slots[target]) T{ std::move(value) };
+    }
+
+    void insert(size_t pos, const T& value) { emplace(pos, value); }
+
+    void insert(size_t pos, T&& value) { emplace(pos, std::move(value)); }
+
+    // Erases [pos, pos + count), shifting the shorter of the remaining sides
+    void erase(size_t pos, size_t count = 1) {
+        if (pos + count > size()) throw std::out_of_range("pos is out of range");
+        if (count == 0) return;
+        auto first = m_begin + pos;
+        for (size_t i = first; i < first + count; ++i) slot(i)->~T();
+        auto after = size() - pos - count;
+        if (pos < after) {
+            for (size_t i = first; i-- > m_begin;) relocate(i, i + count);
+            m_begin += count;
+        } else {
+            for (size_t i = first + count; i < m_end; ++i) relocate(i, i - count);
+            m_end -= count;
+        }
+    }
+
+    void clear() {
+        for (size_t i = m_begin; i < m_end; ++i) slot(i)->~T();
+        m_begin = m_end = capacity() / 2;
+    }
+
+    my_vector<T> to_vector() const {
+        my_vector<T> result;
+        result.reserve(size());
+        for (auto& v : *this) result.push_back(v);
+        return result;
+    }
+
+    iterator begin() noexcept { return data(); }
+
+    iterator end() noexcept { return data() + size(); }
+
+    const_iterator begin() const noexcept { return data(); }
+
+    const_iterator end() const noexcept { return data() + size(); }
+
+    const_iterator cbegin() const noexcept { return data(); }
+
+    const_iterator cend() const noexcept { return data() + size(); }
+
+private:
+    T* base() { return reinterpret_cast<T*>(m_slots.data()); }
+
+    const T* base() const { return reinterpret_cast<const T*>(m_slots.data()); }
+
+    T* slot(size_t physical) {
+        return std::launder(reinterpret_cast<T*>(&m_slots[physical]));
+    }
+
+    const T* slot(size_t physical) const {
+        return std::launder(reinterpret_cast<const T*>(&m_slots[physical]));
+    }
+
+    // Moves the element in slot from to the empty slot to
+    void relocate(size_t from, size_t to) {
+        new (&m_slots[to]) T{ std::move(*slot(from)) };
+        slot(from)->~T();
+    }
+
+    // Gives the front at least count free slots and half of the others
+    void make_room_front(size_t count) {
+        auto free = capacity() - size();
+        if (free < size() + count) free = std::max({capacity() * 2, size() + count, MinCapacity}) - size();
+        place(count + (free - count) / 2, size() + free);
+    }
+
+    // Gives the back at least count free slots and half of the others
+    void make_room_back(size_t count) {
+        auto free = capacity() - size();
+        if (free < size() + count) free = std::max({capacity() * 2, size() + count, MinCapacity}) - size();
+        place((free - count) / 2, size() + free);
+    }
+
+    // Moves the content to start at slot new_begin of a buffer of new_cap slots, in place if the capacity stays
+    void place(size_t new_begin, size_t new_cap) {
+        if (new_cap == capacity()) {
+            if (new_begin < m_begin) {
+                for (size_t i = 0; i < size(); ++i) relocate(m_begin + i, new_begin + i);
+            } else {
+                for (size_t i = size(); i-- > 0;) relocate(m_begin + i, new_begin + i);
+            }
+        } else {
+            my_devector fresh;
+            fresh.m_slots.reserve(new_cap);
+            fresh.m_slots.resize(new_cap);
+            fresh.m_begin = fresh.m_end = new_begin;
+            for (size_t i = m_begin; i < m_end; ++i) {
+                new (&fresh.m_slots[fresh.m_end]) T{ std::move(*slot(i)) };
+                ++fresh.m_end;
+            }
+            swap(fresh);
+            return;
+        }
+        m_end = new_begin + size();
+        m_begin = new_begin;
+    }
+
+private:
+    my_vector<slot_type> m_slots;
+    size_t m_begin = 0;
+    size_t m_end = 0;
+};
+
+}
+
+#endif // MY_DEVECTOR_H
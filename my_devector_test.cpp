@@ -0,0 +1,97 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_devector.h"
+#include <deque>
+#include <random>
+#include <string>
+
+using namespace cpp_training;
+
+TEST(MyDevectorTest, BothEnds) {
+    my_devector<std::string> d {"b", "c"};
+    d.push_front("a");
+    d.push_back("d");
+    d.emplace_front("zz");
+    EXPECT_EQ(d.to_vector(), (my_vector<std::string>{"zz", "a", "b", "c", "d"}));
+    EXPECT_EQ(d.front(), "zz");
+    EXPECT_EQ(d.back(), "d");
+    EXPECT_EQ(d.data()[1], "a");
+    d.pop_front();
+    d.pop_back();
+    EXPECT_EQ(d.to_vector(), (my_vector<std::string>{"a", "b", "c"}));
+    EXPECT_THROW(d.at(3), std::out_of_range);
+    EXPECT_THROW(d.erase(2, 2), std::out_of_range);
+    EXPECT_THROW(d.insert(4, "x"), std::out_of_range);
+
+    // Arguments referring to an element survive the reallocation
+    my_devector<std::string> self;
+    self.push_back("x");
+    for (int i = 0; i < 100; ++i) {
+        self.push_front(self.back());
+        self.push_back(self.front());
+    }
+    EXPECT_EQ(self.size(), 201);
+    for (auto& s : self) ASSERT_EQ(s, "x");
+
+    my_devector<std::string> copy(d);
+    d.clear();
+    EXPECT_TRUE(d.is_empty());
+    EXPECT_EQ(copy.size(), 3);
+    my_devector<std::string> moved(std::move(copy));
+    EXPECT_EQ(moved[2], "c");
+    EXPECT_TRUE(copy.is_empty());
+}
+
+TEST(MyDevectorTest, PushFrontIsAmortizedConstant) {
+    constexpr int Count = 100000;
+    my_devector<int> d;
+    int moves = 0;
+    for (int i = 0; i < Count; ++i) {
+        // Without a move the front free capacity shrinks by one per push_front
+        auto front_free = d.front_free_capacity();
+        d.push_front(i);
+        if (d.front_free_capacity() + 1 != front_free) ++moves;
+    }
+    EXPECT_LT(moves, 40);
+    EXPECT_LE(d.capacity(), 4u * Count);
+    for (int i = 0; i < Count; ++i) ASSERT_EQ(d[i], Count - 1 - i);
+
+    d.reserve_front(1000);
+    EXPECT_GE(d.front_free_capacity(), 1000);
+    d.reserve_back(1000);
+    EXPECT_GE(d.back_free_capacity(), 1000);
+    auto span = d.as_span();
+    EXPECT_EQ(span.size(), Count);
+    EXPECT_EQ(span.front(), Count - 1);
+}
+
+TEST(MyDevectorTest, MatchesDeque) {
+    my_devector<std::string> d;
+    std::deque<std::string> model;
+    std::mt19937 gen(21);
+    for (int i = 0; i < 20000; ++i) {
+        auto value = std::to_string(gen() % 1000);
+        switch (gen() % 8) {
+        case 0: case 1: d.push_front(value); model.push_front(value); break;
+        case 2: case 3: d.push_back(value); model.push_back(value); break;
+        case 4: d.pop_front(); if (!model.empty()) model.pop_front(); break;
+        case 5: d.pop_back(); if (!model.empty()) model.pop_back(); break;
+        case 6: {
+            auto pos = gen() % (model.size() + 1);
+            d.insert(pos, value);
+            model.insert(model.begin() + pos, value);
+            break;
+        }
+        default: {
+            if (model.empty()) break;
+            auto pos = gen() % model.size();
+            auto count = std::min<size_t>(gen() % 4, model.size() - pos);
+            d.erase(pos, count);
+            model.erase(model.begin() + pos, model.begin() + pos + count);
+        }
+        }
+        ASSERT_EQ(d.size(), model.size());
+    }
+    for (size_t i = 0; i < model.size(); ++i) ASSERT_EQ(d[i], model[i]);
+}
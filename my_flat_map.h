@@ -0,0 +1,540 @@
+#ifndef MY_FLAT_MAP_H
+#define MY_FLAT_MAP_H
+
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+
+// Interface : https://en.cppreference.com/w/cpp/container/flat_map
+
+namespace cpp_training {
+
+// Tags for bulk insertion of ranges which are already sorted by key
+struct sorted_unique_t {
+};
+
+struct sorted_equivalent_t {
+};
+
+inline constexpr sorted_unique_t sorted_unique {};
+inline constexpr sorted_equivalent_t sorted_equivalent {};
+
+namespace detail {
+
+// Binary searches without unpredictable branches, the loop runs exactly log2(n) times and compiles to cmov.
+// Return the index of the first element not less than (greater than for upper bound) key in sorted [base, base + n)
+template <typename K, typename Key, typename Compare>
+size_t branchless_lower_bound(const K* base, size_t n, const Key& key, Compare comp) {
+    if (n == 0) return 0;
+    const K* first = base;
+    while (n > 1) {
+        auto half = n / 2;
+        base = comp(base[half - 1], key) ? base + half : base;
+        n -= half;
+    }
+    return (base - first) + comp(*base, key);
+}
+
+template <typename K, typename Key, typename Compare>
+size_t branchless_upper_bound(const K* base, size_t n, const Key& key, Compare comp) {
+    if (n == 0) return 0;
+    const K* first = base;
+    while (n > 1) {
+        auto half = n / 2;
+        base = !comp(key, base[half - 1]) ? base + half : base;
+        n -= half;
+    }
+    return (base - first) + !comp(key, *base);
+}
+
+}
+
+// Sorted vector of keys, the storage for my_flat_set and my_flat_multiset.
+// Lookups are branchless binary searches over one contiguous my_vector,
+// single inserts and erases shift the tail, bulk inserts merge in O(n + m).
+template <typename K, typename Compare, bool Multi>
+class my_basic_flat_set {
+public:
+    using key_type = K;
+    using value_type = K;
+    using key_compare = Compare;
+    using container_type = my_vector<K>;
+    using const_iterator = typename my_vector<K>::const_iterator;
+    using iterator = const_iterator;
+
+public:
+
+    my_basic_flat_set() {
+    }
+
+    explicit my_basic_flat_set(const Compare& comp) : m_comp(comp) {
+    }
+
+    my_basic_flat_set(std::initializer_list<K> lst, const Compare& comp = Compare()) : m_comp(comp) {
+        insert(lst.begin(), lst.end());
+    }
+
+    // Takes a vector which is sorted (and unique for a non multi set) according to comp
+    template <typename Tag>
+    my_basic_flat_set(Tag, my_vector<K> keys, const Compare& comp = Compare())
+        : m_keys(std::move(keys)), m_comp(comp) {
+        static_assert(std::is_same<Tag, sorted_unique_t>::value || std::is_same<Tag, sorted_equivalent_t>::value,
+                      "sorted_unique or sorted_equivalent expected");
+    }
+
+    size_t size() const { return m_keys.size(); }
+
+    bool is_empty() const { return m_keys.is_empty(); }
+
+    void reserve(size_t new_cap) { m_keys.reserve(new_cap); }
+
+    void clear() { m_keys.clear(); }
+
+    const_iterator begin() const noexcept { return m_keys.cbegin(); }
+
+    const_iterator end() const noexcept { return m_keys.cend(); }
+
+    const_iterator cbegin() const noexcept { return m_keys.cbegin(); }
+
+    const_iterator cend() const noexcept { return m_keys.cend(); }
+
+    const K& operator [] (size_t i) const { return m_keys[i]; }
+
+    // For a non multi set the bool is false when an equivalent key already exists
+    std::pair<iterator, bool> insert(const K& key) {
+        if (Multi) {
+            auto pos = upper_index(key);
+            return {m_keys.insert(m_keys.cbegin() + pos, key), true};
+        }
+        auto pos = lower_index(key);
+        if (pos < size() && !m_comp(key, m_keys[pos])) return {begin() + pos, false};
+        return {m_keys.insert(m_keys.cbegin() + pos, key), true};
+    }
+
+    // Inserts an unsorted range: sorts a copy of it and merges it in, O(m log m + n + m)
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        my_vector<K> added(first, last);
+        std::stable_sort(added.data(), added.data() + added.size(), m_comp);
+        merge_in(added);
+    }
+
+    // Inserts a range sorted according to key_comp(), O(n + m)
+    template <typename InputIt>
+    void insert(sorted_unique_t, InputIt first, InputIt last) {
+        merge_in(my_vector<K>(first, last));
+    }
+
+    template <typename InputIt>
+    void insert(sorted_equivalent_t, InputIt first, InputIt last) {
+        merge_in(my_vector<K>(first, last));
+    }
+
+    const_iterator find(const K& key) const {
+        auto pos = lower_index(key);
+        return pos < size() && !m_comp(key, m_keys[pos]) ? begin() + pos : end();
+    }
+
+    bool contains(const K& key) const {
+        return find(key) != end();
+    }
+
+    size_t count(const K& key) const {
+        return upper_index(key) - lower_index(key);
+    }
+
+    const_iterator lower_bound(const K& key) const { return begin() + lower_index(key); }
+
+    const_iterator upper_bound(const K& key) const { return begin() + upper_index(key); }
+
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    // Removes all keys equivalent to key, returns their number
+    size_t erase(const K& key) {
+        auto first = lower_index(key), last = upper_index(key);
+        m_keys.erase(m_keys.cbegin() + first, m_keys.cbegin() + last);
+        return last - first;
+    }
+
+    iterator erase(const_iterator pos) {
+        return m_keys.erase(pos);
+    }
+
+    // Moves the underlying sorted vector out, the set is empty afterwards
+    my_vector<K> extract() {
+        my_vector<K> result(std::move(m_keys));
+        return result;
+    }
+
+    // Replaces the underlying vector, it must be sorted (and unique for a non multi set) according to key_comp()
+    void replace(my_vector<K>&& keys) {
+        m_keys = std::move(keys);
+    }
+
+    const my_vector<K>& keys() const { return m_keys; }
+
+    key_compare key_comp() const { return m_comp; }
+
+    bool operator == (const my_basic_flat_set& rhs) const { return m_keys == rhs.m_keys; }
+
+    bool operator != (const my_basic_flat_set& rhs) const { return !(*this == rhs); }
+
+private:
+    size_t lower_index(const K& key) const {
+        return detail::branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_comp);
+    }
+
+    size_t upper_index(const K& key) const {
+        return detail::branchless_upper_bound(m_keys.data(), m_keys.size(), key, m_comp);
+    }
+
+    // Merges sorted added into m_keys, on equal keys existing ones go first (and win for a non multi set)
+    void merge_in(const my_vector<K>& added) {
+        my_vector<K> result;
+        result.reserve(m_keys.size() + added.size());
+        size_t i = 0, j = 0;
+        while (i < m_keys.size() && j < added.size()) {
+            if (m_comp(added[j], m_keys[i])) {
+                push_unique(result, added[j++]);
+            } else {
+                push_unique(result, m_keys[i++]);
+            }
+        }
+        while (i < m_keys.size()) push_unique(result, m_keys[i++]);
+        while (j < added.size()) push_unique(result, added[j++]);
+        m_keys.swap(result);
+    }
+
+    void push_unique(my_vector<K>& result, const K& key) const {
+        if (Multi || result.is_empty() || m_comp(result.back(), key)) {
+            result.push_back(key);
+        }
+    }
+
+private:
+    my_vector<K> m_keys;
+    Compare m_comp;
+};
+
+template <typename K, typename Compare = std::less<K>>
+using my_flat_set = my_basic_flat_set<K, Compare, false>;
+
+template <typename K, typename Compare = std::less<K>>
+using my_flat_multiset = my_basic_flat_set<K, Compare, true>;
+
+// Sorted associative container with keys and values in two parallel my_vectors,
+// the storage for my_flat_map and my_flat_multimap.
+// Lookups only touch the keys vector, so many more keys fit a cache line than with pairs or tree nodes.
+template <typename K, typename V, typename Compare, bool Multi>
+class my_basic_flat_map {
+    template <bool Const>
+    class map_iterator;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using key_compare = Compare;
+    using iterator = map_iterator<false>;
+    using const_iterator = map_iterator<true>;
+
+    // Both underlying vectors, see extract() and replace()
+    struct containers {
+        my_vector<K> keys;
+        my_vector<V> values;
+    };
+
+public:
+
+    my_basic_flat_map() {
+    }
+
+    explicit my_basic_flat_map(const Compare& comp) : m_comp(comp) {
+    }
+
+    my_basic_flat_map(std::initializer_list<std::pair<K, V>> lst, const Compare& comp = Compare()) : m_comp(comp) {
+        insert(lst.begin(), lst.end());
+    }
+
+    size_t size() const { return m_keys.size(); }
+
+    bool is_empty() const { return m_keys.is_empty(); }
+
+    void reserve(size_t new_cap) {
+        m_keys.reserve(new_cap);
+        m_values.reserve(new_cap);
+    }
+
+    void clear() {
+        m_keys.clear();
+        m_values.clear();
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, size()); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    // For a non multi map the bool is false (and nothing changes) when the key already exists
+    std::pair<iterator, bool> insert(const K& key, const V& value) {
+        return emplace_at(key, value);
+    }
+
+    std::pair<iterator, bool> insert(const std::pair<K, V>& item) {
+        return emplace_at(item.first, item.second);
+    }
+
+    // Non multi map only
+    std::pair<iterator, bool> insert_or_assign(const K& key, const V& value) {
+        static_assert(!Multi, "insert_or_assign is not available for multimaps");
+        auto result = emplace_at(key, value);
+        if (!result.second) m_values[result.first.index()] = value;
+        return result;
+    }
+
+    // Inserts an unsorted range of pairs, sorts a copy of it and merges it in, O(m log m + n + m)
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        containers added;
+        for (; first != last; ++first) {
+            added.keys.push_back(first->first);
+            added.values.push_back(first->second);
+        }
+        // Sort a permutation, keys and values live apart
+        my_vector<size_t> order(added.keys.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.data(), order.data() + order.size(), [this, &added](size_t a, size_t b) {
+            return m_comp(added.keys[a], added.keys[b]);
+        });
+        containers sorted;
+        sorted.keys.reserve(order.size());
+        sorted.values.reserve(order.size());
+        for (auto i : order) {
+            sorted.keys.push_back(std::move(added.keys[i]));
+            sorted.values.push_back(std::move(added.values[i]));
+        }
+        merge_in(sorted);
+    }
+
+    // Inserts a range of pairs sorted according to key_comp(), O(n + m)
+    template <typename InputIt>
+    void insert(sorted_unique_t, InputIt first, InputIt last) {
+        insert_sorted(first, last);
+    }
+
+    template <typename InputIt>
+    void insert(sorted_equivalent_t, InputIt first, InputIt last) {
+        insert_sorted(first, last);
+    }
+
+    // Non multi map only, inserts a value initialized V when the key is missing
+    V& operator [] (const K& key) {
+        static_assert(!Multi, "operator[] is not available for multimaps");
+        return m_values[emplace_at(key, V()).first.index()];
+    }
+
+    V& at(const K& key) {
+        auto pos = find_index(key);
+        if (pos == size()) throw std::out_of_range("key not found");
+        return m_values[pos];
+    }
+
+    const V& at(const K& key) const {
+        auto pos = find_index(key);
+        if (pos == size()) throw std::out_of_range("key not found");
+        return m_values[pos];
+    }
+
+    iterator find(const K& key) { return iterator(this, find_index(key)); }
+
+    const_iterator find(const K& key) const { return const_iterator(this, find_index(key)); }
+
+    bool contains(const K& key) const { return find_index(key) != size(); }
+
+    size_t count(const K& key) const { return upper_index(key) - lower_index(key); }
+
+    iterator lower_bound(const K& key) { return iterator(this, lower_index(key)); }
+
+    const_iterator lower_bound(const K& key) const { return const_iterator(this, lower_index(key)); }
+
+    iterator upper_bound(const K& key) { return iterator(this, upper_index(key)); }
+
+    const_iterator upper_bound(const K& key) const { return const_iterator(this, upper_index(key)); }
+
+    std::pair<iterator, iterator> equal_range(const K& key) { return {lower_bound(key), upper_bound(key)}; }
+
+    // Removes all items with keys equivalent to key, returns their number
+    size_t erase(const K& key) {
+        auto first = lower_index(key), last = upper_index(key);
+        m_keys.erase(m_keys.cbegin() + first, m_keys.cbegin() + last);
+        m_values.erase(m_values.cbegin() + first, m_values.cbegin() + last);
+        return last - first;
+    }
+
+    iterator erase(const_iterator pos) {
+        auto i = pos.index();
+        m_keys.erase(m_keys.cbegin() + i);
+        m_values.erase(m_values.cbegin() + i);
+        return iterator(this, i);
+    }
+
+    // Moves both vectors out, the map is empty afterwards
+    containers extract() {
+        containers result {my_vector<K>(std::move(m_keys)), my_vector<V>(std::move(m_values))};
+        return result;
+    }
+
+    // Replaces the underlying vectors. Keys must be sorted (and unique for a non multi map) according to key_comp(),
+    // both vectors must have the same size
+    void replace(my_vector<K>&& keys, my_vector<V>&& values) {
+        if (keys.size() != values.size()) throw std::invalid_argument("keys and values differ in size");
+        m_keys = std::move(keys);
+        m_values = std::move(values);
+    }
+
+    const my_vector<K>& keys() const { return m_keys; }
+
+    const my_vector<V>& values() const { return m_values; }
+
+    key_compare key_comp() const { return m_comp; }
+
+private:
+    size_t lower_index(const K& key) const {
+        return detail::branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_comp);
+    }
+
+    size_t upper_index(const K& key) const {
+        return detail::branchless_upper_bound(m_keys.data(), m_keys.size(), key, m_comp);
+    }
+
+    // Index of the first item with the key, or size()
+    size_t find_index(const K& key) const {
+        auto pos = lower_index(key);
+        return pos < size() && !m_comp(key, m_keys[pos]) ? pos : size();
+    }
+
+    std::pair<iterator, bool> emplace_at(const K& key, const V& value) {
+        size_t pos;
+        if (Multi) {
+            pos = upper_index(key);
+        } else {
+            pos = lower_index(key);
+            if (pos < size() && !m_comp(key, m_keys[pos])) return {iterator(this, pos), false};
+        }
+        m_keys.insert(m_keys.cbegin() + pos, key);
+        try {
+            m_values.insert(m_values.cbegin() + pos, value);
+        } catch (...) {
+            m_keys.erase(m_keys.cbegin() + pos);
+            throw;
+        }
+        return {iterator(this, pos), true};
+    }
+
+    template <typename InputIt>
+    void insert_sorted(InputIt first, InputIt last) {
+        containers added;
+        for (; first != last; ++first) {
+            added.keys.push_back(first->first);
+            added.values.push_back(first->second);
+        }
+        merge_in(added);
+    }
+
+    // Merges sorted items into the map, on equal keys existing items go first (and win for a non multi map)
+    void merge_in(const containers& added) {
+        containers result;
+        result.keys.reserve(m_keys.size() + added.keys.size());
+        result.values.reserve(m_keys.size() + added.keys.size());
+        auto push = [this, &result](const K& key, const V& value) {
+            if (Multi || result.keys.is_empty() || m_comp(result.keys.back(), key)) {
+                result.keys.push_back(key);
+                result.values.push_back(value);
+            }
+        };
+        size_t i = 0, j = 0;
+        while (i < m_keys.size() && j < added.keys.size()) {
+            if (m_comp(added.keys[j], m_keys[i])) {
+                push(added.keys[j], added.values[j]);
+                ++j;
+            } else {
+                push(m_keys[i], m_values[i]);
+                ++i;
+            }
+        }
+        for (; i < m_keys.size(); ++i) push(m_keys[i], m_values[i]);
+        for (; j < added.keys.size(); ++j) push(added.keys[j], added.values[j]);
+        m_keys.swap(result.keys);
+        m_values.swap(result.values);
+    }
+
+    //
+    // Random access iterator, dereferences to std::pair<const K&, V&>
+    //
+    template <bool Const>
+    class map_iterator {
+        using owner_type = std::conditional_t<Const, const my_basic_flat_map, my_basic_flat_map>;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = ptrdiff_t;
+        using reference = std::pair<const K&, std::conditional_t<Const, const V&, V&>>;
+
+        // operator -> needs an address, the pair reference lives in the proxy
+        struct pointer {
+            reference ref;
+            reference* operator -> () { return &ref; }
+        };
+    public:
+        map_iterator() {}
+        map_iterator(owner_type* owner_p, size_t pos) : m_owner_p(owner_p), m_pos(pos) {}
+        operator map_iterator<true> () const { return map_iterator<true>(m_owner_p, m_pos); }
+        size_t index() const { return m_pos; }
+        map_iterator operator ++ (int) { return map_iterator(m_owner_p, m_pos++); }
+        map_iterator& operator ++ () { ++m_pos; return *this; }
+        map_iterator operator -- (int) { return map_iterator(m_owner_p, m_pos--); }
+        map_iterator& operator -- () { --m_pos; return *this; }
+        difference_type operator - (map_iterator rhs) const { return static_cast<difference_type>(m_pos - rhs.m_pos); }
+        map_iterator& operator += (difference_type n) { m_pos += n; return *this; }
+        map_iterator& operator -= (difference_type n) { m_pos -= n; return *this; }
+        map_iterator operator - (difference_type n) const { return map_iterator(m_owner_p, m_pos - n); }
+        map_iterator operator + (difference_type n) const { return map_iterator(m_owner_p, m_pos + n); }
+        reference operator * () const { return reference(m_owner_p->m_keys[m_pos], m_owner_p->m_values[m_pos]); }
+        pointer operator -> () const { return pointer{**this}; }
+        reference operator [] (difference_type n) const { return *(*this + n); }
+        bool operator == (map_iterator rhs) const { return m_pos == rhs.m_pos; }
+        bool operator != (map_iterator rhs) const { return m_pos != rhs.m_pos; }
+        bool operator < (map_iterator rhs) const { return m_pos < rhs.m_pos; }
+        bool operator > (map_iterator rhs) const { return m_pos > rhs.m_pos; }
+    private:
+        owner_type* m_owner_p = nullptr;
+        size_t m_pos = 0;
+    };
+
+private:
+    my_vector<K> m_keys;
+    my_vector<V> m_values;
+    Compare m_comp;
+};
+
+template <typename K, typename V, typename Compare = std::less<K>>
+using my_flat_map = my_basic_flat_map<K, V, Compare, false>;
+
+template <typename K, typename V, typename Compare = std::less<K>>
+using my_flat_multimap = my_basic_flat_map<K, V, Compare, true>;
+
+}
+
+#endif // MY_FLAT_MAP_H
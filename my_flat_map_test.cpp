@@ -0,0 +1,196 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_flat_map.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace cpp_training;
+
+TEST(MyFlatMapTest, BranchlessBounds) {
+    std::less<int> comp;
+    for (int n = 0; n < 40; ++n) {
+        my_vector<int> keys;
+        for (int i = 0; i < n; ++i) keys.push_back(i / 3 * 2);
+        for (int key = -1; key < n; ++key) {
+            auto lower = std::lower_bound(keys.data(), keys.data() + keys.size(), key) - keys.data();
+            auto upper = std::upper_bound(keys.data(), keys.data() + keys.size(), key) - keys.data();
+            EXPECT_EQ(detail::branchless_lower_bound(keys.data(), keys.size(), key, comp), lower);
+            EXPECT_EQ(detail::branchless_upper_bound(keys.data(), keys.size(), key, comp), upper);
+        }
+    }
+}
+
+TEST(MyFlatMapTest, FlatSet) {
+    my_flat_set<int> set {5, 1, 3, 3, 9};
+    EXPECT_EQ(set.size(), 4);
+    EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_FALSE(set.contains(4));
+    EXPECT_EQ(set.count(3), 1);
+
+    auto result = set.insert(4);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(*result.first, 4);
+    result = set.insert(4);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(set.size(), 5);
+
+    EXPECT_EQ(*set.lower_bound(2), 3);
+    EXPECT_EQ(*set.upper_bound(4), 5);
+    EXPECT_TRUE(set.find(7) == set.end());
+
+    EXPECT_EQ(set.erase(3), 1);
+    EXPECT_EQ(set.erase(3), 0);
+    auto it = set.erase(set.find(1));
+    EXPECT_EQ(*it, 4);
+    EXPECT_EQ(set.keys(), (my_vector<int>{4, 5, 9}));
+}
+
+TEST(MyFlatMapTest, FlatMultiset) {
+    my_flat_multiset<std::string> set {"b", "a", "b"};
+    EXPECT_EQ(set.size(), 3);
+    set.insert("b");
+    EXPECT_EQ(set.count("b"), 3);
+    auto range = set.equal_range("b");
+    EXPECT_EQ(range.second - range.first, 3);
+    EXPECT_EQ(set.erase("b"), 3);
+    EXPECT_EQ(set.size(), 1);
+}
+
+TEST(MyFlatMapTest, SetBulkInsert) {
+    my_flat_set<int> set {10, 20, 30};
+    my_vector<int> sorted {5, 20, 25, 40};
+    set.insert(sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_EQ(set.keys(), (my_vector<int>{5, 10, 20, 25, 30, 40}));
+
+    my_vector<int> unsorted {7, 3, 7, 50};
+    set.insert(unsorted.begin(), unsorted.end());
+    EXPECT_EQ(set.keys(), (my_vector<int>{3, 5, 7, 10, 20, 25, 30, 40, 50}));
+
+    my_flat_multiset<int> multi {1, 2};
+    multi.insert(sorted_equivalent, sorted.begin(), sorted.end());
+    multi.insert(sorted_equivalent, sorted.begin(), sorted.end());
+    EXPECT_EQ(multi.size(), 10);
+    EXPECT_EQ(multi.count(20), 2);
+}
+
+TEST(MyFlatMapTest, SetExtractReplace) {
+    my_flat_set<int, std::greater<int>> set {1, 3, 2};
+    EXPECT_EQ(set.keys(), (my_vector<int>{3, 2, 1}));
+    auto keys = set.extract();
+    EXPECT_TRUE(set.is_empty());
+    keys.push_back(0);
+    set.replace(std::move(keys));
+    EXPECT_TRUE(set.contains(0));
+    EXPECT_EQ(set.size(), 4);
+
+    my_flat_set<int> adopted(sorted_unique, my_vector<int>{1, 2, 4});
+    EXPECT_TRUE(adopted.contains(4));
+    EXPECT_FALSE(adopted.contains(3));
+}
+
+TEST(MyFlatMapTest, FlatMap) {
+    my_flat_map<std::string, int> map {{"one", 1}, {"three", 3}, {"two", 2}};
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at("two"), 2);
+    EXPECT_THROW(map.at("four"), std::out_of_range);
+
+    map["four"] = 4;
+    EXPECT_EQ(map.size(), 4);
+    ++map["four"];
+    EXPECT_EQ(map.at("four"), 5);
+
+    auto result = map.insert("one", 100);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first->second, 1);
+    result = map.insert_or_assign("one", 100);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(map.at("one"), 100);
+
+    EXPECT_EQ(map.keys(), (my_vector<std::string>{"four", "one", "three", "two"}));
+    EXPECT_EQ(map.values(), (my_vector<int>{5, 100, 3, 2}));
+
+    for (auto item : map) {
+        item.second *= 2;
+    }
+    EXPECT_EQ(map.at("three"), 6);
+
+    auto it = map.find("three");
+    EXPECT_EQ((*it).first, "three");
+    it = map.erase(it);
+    EXPECT_EQ(it->first, "two");
+    EXPECT_EQ(map.erase("four"), 1);
+    EXPECT_FALSE(map.contains("four"));
+    EXPECT_EQ(map.size(), 2);
+
+    const auto& cmap = map;
+    EXPECT_EQ(cmap.find("two")->second, 4);
+    EXPECT_TRUE(cmap.find("zero") == cmap.end());
+}
+
+TEST(MyFlatMapTest, FlatMultimap) {
+    my_flat_multimap<int, std::string> map;
+    map.insert(1, "a");
+    map.insert(2, "b");
+    map.insert(1, "c");
+    EXPECT_EQ(map.count(1), 2);
+    auto range = map.equal_range(1);
+    EXPECT_EQ(range.first->second, "a");
+    EXPECT_EQ((++range.first)->second, "c");
+    EXPECT_EQ(map.erase(1), 2);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(MyFlatMapTest, MapBulkInsertAndExtract) {
+    my_flat_map<int, int> map {{10, 1}, {30, 3}};
+    std::vector<std::pair<int, int>> sorted {{5, 0}, {10, 99}, {20, 2}};
+    map.insert(sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_EQ(map.keys(), (my_vector<int>{5, 10, 20, 30}));
+    EXPECT_EQ(map.at(10), 1);
+
+    std::vector<std::pair<int, int>> unsorted {{40, 4}, {1, -1}, {40, 44}};
+    map.insert(unsorted.begin(), unsorted.end());
+    EXPECT_EQ(map.keys(), (my_vector<int>{1, 5, 10, 20, 30, 40}));
+    EXPECT_EQ(map.at(40), 4);
+
+    auto parts = map.extract();
+    EXPECT_TRUE(map.is_empty());
+    EXPECT_EQ(parts.values, (my_vector<int>{-1, 0, 1, 2, 3, 4}));
+    parts.values.pop_back();
+    EXPECT_THROW(map.replace(std::move(parts.keys), std::move(parts.values)), std::invalid_argument);
+    map.replace(my_vector<int>{1, 2}, my_vector<int>{10, 20});
+    EXPECT_EQ(map.at(2), 20);
+}
+
+TEST(MyFlatMapTest, MatchesStdMap) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 200);
+    my_flat_map<int, int> flat;
+    std::map<int, int> model;
+    for (int i = 0; i < 2000; ++i) {
+        auto key = dist(gen);
+        switch (i % 3) {
+        case 0:
+            flat.insert_or_assign(key, i);
+            model[key] = i;
+            break;
+        case 1:
+            flat[key] += 1;
+            model[key] += 1;
+            break;
+        default:
+            EXPECT_EQ(flat.erase(key), model.erase(key));
+        }
+    }
+    ASSERT_EQ(flat.size(), model.size());
+    auto it = flat.begin();
+    for (auto& item : model) {
+        EXPECT_EQ(it->first, item.first);
+        EXPECT_EQ(it->second, item.second);
+        ++it;
+    }
+}
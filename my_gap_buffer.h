@@ -0,0 +1,335 @@
+#ifndef MY_GAP_BUFFER_H
+#define MY_GAP_BUFFER_H
+
+#include <new>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_span.h"
+
+namespace cpp_training {
+
+// Sequence with a movable gap of free slots, as used by text editors.
+// The content is [0, gap_begin) and [gap_end, capacity) of a my_vector of raw slots.
+// Insertions and erasures happen at the gap, moving it costs the distance moved,
+// so a run of edits around one cursor costs O(1) amortized per element instead of shifting the tail every time.
+template <typename T>
+class my_gap_buffer {
+    template <bool Const>
+    class gap_iterator;
+
+    using slot_type = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    static constexpr size_t MinCapacity = 16;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = gap_iterator<false>;
+    using const_iterator = gap_iterator<true>;
+    using span_type = my_span<T>;
+    using const_span_type = my_span<const T>;
+
+public:
+
+    my_gap_buffer() {
+    }
+
+    my_gap_buffer(std::initializer_list<T> lst) {
+        reserve(lst.size());
+        for (auto& v : lst) push_back(v);
+    }
+
+    explicit my_gap_buffer(const my_vector<T>& values) {
+        insert(0, values);
+    }
+
+    my_gap_buffer(const my_gap_buffer& rhs) {
+        reserve(rhs.size());
+        for (size_t i = 0; i < rhs.size(); ++i) push_back(rhs[i]);
+    }
+
+    my_gap_buffer(my_gap_buffer&& rhs) noexcept
+        : m_slots(std::move(rhs.m_slots)), m_gap_begin(rhs.m_gap_begin), m_gap_end(rhs.m_gap_end) {
+        rhs.m_gap_begin = 0;
+        rhs.m_gap_end = 0;
+    }
+
+    ~my_gap_buffer() noexcept {
+        clear();
+    }
+
+    my_gap_buffer& operator = (const my_gap_buffer& rhs) {
+        my_gap_buffer tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_gap_buffer& operator = (my_gap_buffer&& rhs) noexcept {
+        my_gap_buffer tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(my_gap_buffer& rhs) noexcept {
+        m_slots.swap(rhs.m_slots);
+        std::swap(m_gap_begin, rhs.m_gap_begin);
+        std::swap(m_gap_end, rhs.m_gap_end);
+    }
+
+    size_t size() const { return capacity() - gap_size(); }
+
+    size_t capacity() const { return m_slots.size(); }
+
+    bool is_empty() const { return size() == 0; }
+
+    // Position of the gap, where the next insert() at the same place goes without moving anything
+    size_t gap_position() const { return m_gap_begin; }
+
+    size_t gap_size() const { return m_gap_end - m_gap_begin; }
+
+    void reserve(size_t new_cap) {
+        if (new_cap > capacity()) reallocate(new_cap);
+    }
+
+    T& operator [] (size_t i) { return *slot(physical(i)); }
+
+    const T& operator [] (size_t i) const { return *slot(physical(i)); }
+
+    T& at (size_t pos) {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        return (*this)[pos];
+    }
+
+    const T& at (size_t pos) const {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        return (*this)[pos];
+    }
+
+    T& front() { return (*this)[0]; }
+
+    const T& front() const { return (*this)[0]; }
+
+    T& back() { return (*this)[size() - 1]; }
+
+    const T& back() const { return (*this)[size() - 1]; }
+
+    // Moves the gap to pos, 0 <= pos <= size(), O(|pos - gap_position()|)
+    void move_gap(size_t pos) {
+        if (pos > size()) throw std::out_of_range("pos is out of range");
+        while (m_gap_begin > pos) {
+            // The element before the gap goes to its end
+            --m_gap_begin;
+            --m_gap_end;
+            relocate(m_gap_begin, m_gap_end);
+        }
+        while (m_gap_begin < pos) {
+            relocate(m_gap_end, m_gap_begin);
+            ++m_gap_begin;
+            ++m_gap_end;
+        }
+    }
+
+    // args may refer to elements of this buffer
+    template< class... Args >
+    T& emplace(size_t pos, Args&&... args) {
+        if (pos == m_gap_begin && gap_size() > 0) {
+            // Nothing moves, args stay valid
+            auto p = new (&m_slots[m_gap_begin]) T{ std::forward<Args>(args)... };
+            ++m_gap_begin;
+            return *p;
+        }
+        // Moving the gap or reallocating relocates the elements args may refer to, so the value is built first
+        T value{ std::forward<Args>(args)... };
+        make_room(pos, 1);
+        auto p = new (&m_slots[m_gap_begin]) T{ std::move(value) };
+        ++m_gap_begin;
+        return *p;
+    }
+
+    void insert(size_t pos, const T& value) { emplace(pos, value); }
+
+    void insert(size_t pos, T&& value) { emplace(pos, std::move(value)); }
+
+    // values may point into this buffer
+    void insert(size_t pos, const T* values, size_t count) {
+        if (count && contains_address(values)) {
+            my_vector<T> copy(values, values + count);
+            insert(pos, copy.data(), count);
+            return;
+        }
+        make_room(pos, count);
+        for (size_t i = 0; i < count; ++i) {
+            new (&m_slots[m_gap_begin]) T{ values[i] };
+            ++m_gap_begin;
+        }
+    }
+
+    void insert(size_t pos, const my_vector<T>& values) {
+        insert(pos, values.data(), values.size());
+    }
+
+    // Erases [pos, pos + count)
+    void erase(size_t pos, size_t count = 1) {
+        if (pos + count > size()) throw std::out_of_range("pos is out of range");
+        move_gap(pos);
+        for (size_t i = 0; i < count; ++i) {
+            slot(m_gap_end)->~T();
+            ++m_gap_end;
+        }
+    }
+
+    void push_back(const T& value) { emplace(size(), value); }
+
+    void push_back(T&& value) { emplace(size(), std::move(value)); }
+
+    void pop_back() {
+        if (!is_empty()) erase(size() - 1);
+    }
+
+    void clear() {
+        for (size_t i = 0; i < m_gap_begin; ++i) slot(i)->~T();
+        for (size_t i = m_gap_end; i < capacity(); ++i) slot(i)->~T();
+        m_gap_begin = 0;
+        m_gap_end = capacity();
+    }
+
+    // The content as the parts before and after the gap
+    std::pair<span_type, span_type> as_spans() {
+        auto base = reinterpret_cast<T*>(m_slots.data());
+        return {span_type(base, m_gap_begin), span_type(base + m_gap_end, capacity() - m_gap_end)};
+    }
+
+    std::pair<const_span_type, const_span_type> as_spans() const {
+        auto base = reinterpret_cast<const T*>(m_slots.data());
+        return {const_span_type(base, m_gap_begin), const_span_type(base + m_gap_end, capacity() - m_gap_end)};
+    }
+
+    my_vector<T> to_vector() const {
+        my_vector<T> result;
+        result.reserve(size());
+        for (size_t i = 0; i < size(); ++i) result.push_back((*this)[i]);
+        return result;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, size()); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator cend() const noexcept { return const_iterator(this, size()); }
+
+private:
+    size_t physical(size_t i) const { return i < m_gap_begin ? i : i + gap_size(); }
+
+    T* slot(size_t physical) {
+        return std::launder(reinterpret_cast<T*>(&m_slots[physical]));
+    }
+
+    const T* slot(size_t physical) const {
+        return std::launder(reinterpret_cast<const T*>(&m_slots[physical]));
+    }
+
+    bool contains_address(const T* p) const {
+        std::less<const void*> less;
+        const void* first = m_slots.data();
+        return !less(p, first) && less(p, m_slots.data() + m_slots.size());
+    }
+
+    // Moves the element in slot from to the empty slot to
+    void relocate(size_t from, size_t to) {
+        new (&m_slots[to]) T{ std::move(*slot(from)) };
+        slot(from)->~T();
+    }
+
+    // Moves the gap to pos and makes it at least count slots large
+    void make_room(size_t pos, size_t count) {
+        if (pos > size()) throw std::out_of_range("pos is out of range");
+        if (gap_size() < count) {
+            reallocate(std::max({capacity() * 2, size() + count, MinCapacity}), pos);
+        } else {
+            move_gap(pos);
+        }
+    }
+
+    // Moves the content into new_cap slots with the gap at gap_pos
+    void reallocate(size_t new_cap, size_t gap_pos) {
+        my_gap_buffer fresh;
+        fresh.m_slots.reserve(new_cap);
+        fresh.m_slots.resize(new_cap);
+        auto count = size();
+        auto tail = count - gap_pos;
+        fresh.m_gap_end = new_cap;
+        for (size_t i = 0; i < gap_pos; ++i) {
+            new (&fresh.m_slots[i]) T{ std::move((*this)[i]) };
+            ++fresh.m_gap_begin;
+        }
+        // The tail is built backwards, so fresh stays consistent if a move throws
+        for (size_t i = 0; i < tail; ++i) {
+            new (&fresh.m_slots[new_cap - 1 - i]) T{ std::move((*this)[count - 1 - i]) };
+            --fresh.m_gap_end;
+        }
+        swap(fresh);
+    }
+
+    void reallocate(size_t new_cap) {
+        reallocate(new_cap, m_gap_begin);
+    }
+
+    //
+    // Random access iterator over the logical order, skips the gap
+    //
+    template <bool Const>
+    class gap_iterator {
+        using owner_type = std::conditional_t<Const, const my_gap_buffer, my_gap_buffer>;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+    public:
+        gap_iterator() {}
+        gap_iterator(owner_type* owner_p, size_t pos) : m_owner_p(owner_p), m_pos(pos) {}
+        operator gap_iterator<true> () const { return gap_iterator<true>(m_owner_p, m_pos); }
+        gap_iterator operator ++ (int) { return gap_iterator(m_owner_p, m_pos++); }
+        gap_iterator& operator ++ () { ++m_pos; return *this; }
+        gap_iterator operator -- (int) { return gap_iterator(m_owner_p, m_pos--); }
+        gap_iterator& operator -- () { --m_pos; return *this; }
+        difference_type operator - (gap_iterator rhs) const { return static_cast<difference_type>(m_pos - rhs.m_pos); }
+        gap_iterator& operator += (difference_type n) { m_pos += n; return *this; }
+        gap_iterator& operator -= (difference_type n) { m_pos -= n; return *this; }
+        gap_iterator operator - (difference_type n) const { return gap_iterator(m_owner_p, m_pos - n); }
+        gap_iterator operator + (difference_type n) const { return gap_iterator(m_owner_p, m_pos + n); }
+        pointer operator -> () const { return &(*m_owner_p)[m_pos]; }
+        reference operator * () const { return (*m_owner_p)[m_pos]; }
+        reference operator [] (difference_type n) const { return (*m_owner_p)[m_pos + n]; }
+        bool operator == (gap_iterator rhs) const { return m_pos == rhs.m_pos; }
+        bool operator != (gap_iterator rhs) const { return m_pos != rhs.m_pos; }
+        bool operator < (gap_iterator rhs) const { return m_pos < rhs.m_pos; }
+        bool operator > (gap_iterator rhs) const { return m_pos > rhs.m_pos; }
+        bool operator <= (gap_iterator rhs) const { return m_pos <= rhs.m_pos; }
+        bool operator >= (gap_iterator rhs) const { return m_pos >= rhs.m_pos; }
+    private:
+        owner_type* m_owner_p = nullptr;
+        size_t m_pos = 0;
+    };
+
+private:
+    my_vector<slot_type> m_slots;
+    size_t m_gap_begin = 0;
+    size_t m_gap_end = 0;
+};
+
+}
+
+#endif // MY_GAP_BUFFER_H
@@ -0,0 +1,111 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_gap_buffer.h"
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace cpp_training;
+
+namespace {
+
+std::string text(const my_gap_buffer<char>& buffer) {
+    return std::string(buffer.begin(), buffer.end());
+}
+
+}
+
+TEST(MyGapBufferTest, Typing) {
+    my_gap_buffer<char> buffer;
+    EXPECT_TRUE(buffer.is_empty());
+    for (char c : std::string("helo world")) buffer.push_back(c);
+    EXPECT_EQ(text(buffer), "helo world");
+
+    // Cursor after "hel"
+    buffer.insert(3, 'l');
+    EXPECT_EQ(buffer.gap_position(), 4);
+    buffer.insert(4, ',');
+    buffer.erase(4);
+    EXPECT_EQ(text(buffer), "hello world");
+
+    auto parts = buffer.as_spans();
+    EXPECT_EQ(parts.first.size() + parts.second.size(), buffer.size());
+    EXPECT_EQ(std::string(parts.first.begin(), parts.first.end()), "hell");
+
+    buffer.erase(5, 6);
+    EXPECT_EQ(text(buffer), "hello");
+    EXPECT_EQ(buffer.back(), 'o');
+    buffer.pop_back();
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_THROW(buffer.erase(4), std::out_of_range);
+    EXPECT_THROW(buffer.insert(5, 'x'), std::out_of_range);
+    EXPECT_THROW(buffer.at(4), std::out_of_range);
+}
+
+TEST(MyGapBufferTest, NonTrivialElements) {
+    my_gap_buffer<std::string> lines {"one", "three"};
+    lines.insert(1, std::string("two"));
+    lines.emplace(0, "zero");
+    my_vector<std::string> more {"four", "five"};
+    lines.insert(lines.size(), more);
+    EXPECT_EQ(lines.to_vector(), (my_vector<std::string>{"zero", "one", "two", "three", "four", "five"}));
+
+    my_gap_buffer<std::string> copy(lines);
+    lines.move_gap(0);
+    EXPECT_EQ(lines[2], "two");
+    EXPECT_EQ(copy.to_vector(), lines.to_vector());
+    my_gap_buffer<std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 6);
+    EXPECT_EQ(copy.size(), 0);
+    copy = moved;
+    EXPECT_EQ(copy[5], "five");
+
+    std::sort(lines.begin(), lines.end());
+    EXPECT_EQ(lines.front(), "five");
+    lines.clear();
+    EXPECT_TRUE(lines.is_empty());
+}
+
+TEST(MyGapBufferTest, InsertOwnElements) {
+    // Heap allocated strings, so a read of a relocated element shows up
+    const std::string a(40, 'a'), b(40, 'b');
+    my_gap_buffer<std::string> lines {a, b};
+    ASSERT_EQ(lines.size(), lines.capacity());
+    // Full buffer: reallocates
+    lines.insert(0, lines[1]);
+    // The gap moves over the element
+    lines.move_gap(lines.size());
+    lines.insert(0, lines[2]);
+    lines.emplace(3, lines[2]);
+    EXPECT_EQ(lines.to_vector(), (my_vector<std::string>{b, b, a, a, b}));
+
+    // From the part after the gap, which moves before it
+    lines.move_gap(1);
+    auto parts = lines.as_spans();
+    lines.insert(4, parts.second.data() + 2, 2);
+    EXPECT_EQ(lines.to_vector(), (my_vector<std::string>{b, b, a, a, a, b, b}));
+}
+
+TEST(MyGapBufferTest, MatchesString) {
+    my_gap_buffer<char> buffer(my_vector<char>{'a', 'b'});
+    std::string model = "ab";
+    std::mt19937 gen(9);
+    size_t cursor = 0;
+    for (int i = 0; i < 20000; ++i) {
+        // Mostly local edits around a cursor which jumps now and then
+        if (gen() % 50 == 0) cursor = gen() % (model.size() + 1);
+        if (gen() % 3 || model.empty()) {
+            char c = 'a' + gen() % 26;
+            buffer.insert(cursor, c);
+            model.insert(model.begin() + cursor, c);
+            ++cursor;
+        } else if (cursor > 0) {
+            --cursor;
+            buffer.erase(cursor);
+            model.erase(cursor, 1);
+        }
+    }
+    EXPECT_EQ(text(buffer), model);
+    EXPECT_GE(buffer.capacity(), buffer.size());
+}
@@ -0,0 +1,401 @@
+#ifndef MY_HIVE_H
+#define MY_HIVE_H
+
+#include <new>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+
+// Interface after plf::hive / P0447 : https://wg21.link/p0447
+
+namespace cpp_training {
+
+// Unordered container whose elements never move: they live in a chain of blocks of raw slots,
+// erase leaves a hole which a later insert reuses, so pointers and iterators to live elements stay valid.
+// Every block has a jump-counting skipfield (Bentley's low complexity variant): the first and the last
+// entry of a run of erased slots hold its length, live slots hold 0, so iteration jumps over a run in O(1).
+// The runs of a block form a free list, insert takes the first slot of a run from a block with holes,
+// otherwise appends to the last block or starts a new one, as large as the hive up to MaxBlockCapacity.
+// Blocks that become empty are kept as spares for later blocks.
+template <typename T>
+class my_hive {
+    using slot_type = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    static constexpr uint16_t NoRun = UINT16_MAX;
+    static constexpr size_t NoIndex = SIZE_MAX;
+
+    // Neighbours of a run in the free list of its block, kept at the first slot of the run
+    struct run_links {
+        uint16_t prev = NoRun;
+        uint16_t next = NoRun;
+    };
+
+    struct block {
+        explicit block(size_t cap) : capacity(cap) {
+            slots.reserve(cap);
+            slots.resize(cap);
+            skip.resize(cap + 1);
+            links.resize(cap);
+        }
+
+        T* slot(size_t i) { return std::launder(reinterpret_cast<T*>(&slots[i])); }
+
+        my_vector<slot_type> slots;
+        my_vector<uint16_t> skip;       // One more entry than slots, always 0, stops iteration at top
+        my_vector<run_links> links;
+        size_t capacity;
+        size_t top = 0;                 // Slots [0, top) were used, [top, capacity) never were
+        size_t live = 0;
+        uint16_t free_head = NoRun;     // First slot of the first run of erased slots
+        size_t holes_index = NoIndex;   // Position in m_with_holes
+        block* prev = nullptr;
+        block* next = nullptr;
+    };
+
+    template <bool Const>
+    class hive_iterator;
+
+public:
+    static constexpr size_t MinBlockCapacity = 16;
+    static constexpr size_t MaxBlockCapacity = 8192;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = hive_iterator<false>;
+    using const_iterator = hive_iterator<true>;
+
+public:
+
+    my_hive() {
+    }
+
+    my_hive(std::initializer_list<T> lst) {
+        reserve(lst.size());
+        for (auto& v : lst) insert(v);
+    }
+
+    my_hive(const my_hive& rhs) {
+        reserve(rhs.size());
+        for (auto& v : rhs) insert(v);
+    }
+
+    my_hive(my_hive&& rhs) noexcept {
+        swap(rhs);
+    }
+
+    ~my_hive() noexcept {
+        clear();
+        shrink_to_fit();
+    }
+
+    my_hive& operator = (const my_hive& rhs) {
+        my_hive tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_hive& operator = (my_hive&& rhs) noexcept {
+        my_hive tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(my_hive& rhs) noexcept {
+        std::swap(m_first, rhs.m_first);
+        std::swap(m_last, rhs.m_last);
+        m_with_holes.swap(rhs.m_with_holes);
+        m_spares.swap(rhs.m_spares);
+        std::swap(m_size, rhs.m_size);
+        std::swap(m_capacity, rhs.m_capacity);
+    }
+
+    size_t size() const { return m_size; }
+
+    bool is_empty() const { return m_size == 0; }
+
+    // Slots in all blocks, spares included
+    size_t capacity() const { return m_capacity; }
+
+    // Adds spare blocks until new_cap elements fit
+    void reserve(size_t new_cap) {
+        while (m_capacity < new_cap) {
+            auto cap = std::min(std::max(new_cap - m_capacity, MinBlockCapacity), MaxBlockCapacity);
+            m_spares.push_back(new block(cap));
+            m_capacity += cap;
+        }
+    }
+
+    // Frees the spare blocks
+    void shrink_to_fit() {
+        for (auto b : m_spares) {
+            m_capacity -= b->capacity;
+            delete b;
+        }
+        m_spares.clear();
+    }
+
+    template< class... Args >
+    iterator emplace( Args&&... args ) {
+        if (!m_with_holes.is_empty()) {
+            auto b = m_with_holes.back();
+            auto s = b->free_head;
+            new (&b->slots[s]) T{ std::forward<Args>(args)... };
+            reuse_run_start(b, s);
+            ++b->live;
+            ++m_size;
+            return iterator(b, s);
+        }
+        if (!m_last || m_last->top == m_last->capacity) {
+            auto b = take_block();
+            try {
+                new (&b->slots[0]) T{ std::forward<Args>(args)... };
+            } catch (...) {
+                m_spares.push_back(b);
+                throw;
+            }
+            append_block(b);
+        } else {
+            new (&m_last->slots[m_last->top]) T{ std::forward<Args>(args)... };
+        }
+        ++m_last->top;
+        ++m_last->live;
+        ++m_size;
+        return iterator(m_last, m_last->top - 1);
+    }
+
+    iterator insert(const T& value) { return emplace(value); }
+
+    iterator insert(T&& value) { return emplace(std::move(value)); }
+
+    // Returns the iterator following pos, other iterators stay valid
+    iterator erase(const_iterator pos) {
+        auto b = pos.m_block_p;
+        auto i = pos.m_index;
+        auto next = pos;
+        ++next;
+        b->slot(i)->~T();
+        --b->live;
+        --m_size;
+        if (b->live == 0) {
+            retire_block(b);
+            return next.m_block_p == b ? end() : iterator(next.m_block_p, next.m_index);
+        }
+        erase_slot(b, i);
+        return iterator(next.m_block_p, next.m_index);
+    }
+
+    // Iterator to the element at p, which must be in the hive, O(number of blocks)
+    iterator get_iterator(const T* p) {
+        auto where = locate(p);
+        return iterator(where.first, where.second);
+    }
+
+    const_iterator get_iterator(const T* p) const {
+        auto where = locate(p);
+        return const_iterator(where.first, where.second);
+    }
+
+    // Destroys the elements, keeps the blocks as spares
+    void clear() {
+        for (auto b = m_first; b;) {
+            auto next = b->next;
+            for (auto it = iterator(b, b->skip[0]); it.m_block_p == b && it.m_index < b->top; ++it) it->~T();
+            reset_block(b);
+            m_spares.push_back(b);
+            b = next;
+        }
+        m_first = m_last = nullptr;
+        m_with_holes.clear();
+        m_size = 0;
+    }
+
+    iterator begin() noexcept { return m_first ? iterator(m_first, m_first->skip[0]) : iterator(); }
+
+    iterator end() noexcept { return m_last ? iterator(m_last, m_last->top) : iterator(); }
+
+    const_iterator begin() const noexcept { return m_first ? const_iterator(m_first, m_first->skip[0]) : const_iterator(); }
+
+    const_iterator end() const noexcept { return m_last ? const_iterator(m_last, m_last->top) : const_iterator(); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    std::pair<block*, size_t> locate(const T* p) const {
+        for (auto b = m_first; b; b = b->next) {
+            auto first = reinterpret_cast<const T*>(b->slots.data());
+            if (p >= first && p < first + b->top) return {b, static_cast<size_t>(p - first)};
+        }
+        throw std::invalid_argument("pointer is not in the hive");
+    }
+
+    block* take_block() {
+        if (!m_spares.is_empty()) {
+            auto b = m_spares.back();
+            m_spares.pop_back();
+            return b;
+        }
+        auto cap = std::min(std::max(m_size, MinBlockCapacity), MaxBlockCapacity);
+        auto b = new block(cap);
+        m_capacity += cap;
+        return b;
+    }
+
+    void append_block(block* b) {
+        b->prev = m_last;
+        b->next = nullptr;
+        if (m_last) m_last->next = b; else m_first = b;
+        m_last = b;
+    }
+
+    void reset_block(block* b) {
+        std::fill(b->skip.begin(), b->skip.end(), 0);
+        b->top = 0;
+        b->live = 0;
+        b->free_head = NoRun;
+        b->holes_index = NoIndex;
+        b->prev = b->next = nullptr;
+    }
+
+    // Unlinks a block without live elements and keeps it as a spare
+    void retire_block(block* b) {
+        if (b->prev) b->prev->next = b->next; else m_first = b->next;
+        if (b->next) b->next->prev = b->prev; else m_last = b->prev;
+        forget_holes(b);
+        reset_block(b);
+        m_spares.push_back(b);
+    }
+
+    void forget_holes(block* b) {
+        if (b->holes_index == NoIndex) return;
+        auto last = m_with_holes.back();
+        m_with_holes[b->holes_index] = last;
+        last->holes_index = b->holes_index;
+        m_with_holes.pop_back();
+        b->holes_index = NoIndex;
+    }
+
+    void push_run(block* b, uint16_t s) {
+        b->links[s] = run_links{NoRun, b->free_head};
+        if (b->free_head != NoRun) b->links[b->free_head].prev = s;
+        b->free_head = s;
+        if (b->holes_index == NoIndex) {
+            b->holes_index = m_with_holes.size();
+            m_with_holes.push_back(b);
+        }
+    }
+
+    void unlink_run(block* b, uint16_t s) {
+        auto links = b->links[s];
+        if (links.prev != NoRun) b->links[links.prev].next = links.next; else b->free_head = links.next;
+        if (links.next != NoRun) b->links[links.next].prev = links.prev;
+        if (b->free_head == NoRun) forget_holes(b);
+    }
+
+    // The run starting at from starts at to instead
+    void move_run(block* b, uint16_t from, uint16_t to) {
+        auto links = b->links[from];
+        b->links[to] = links;
+        if (links.prev != NoRun) b->links[links.prev].next = to; else b->free_head = to;
+        if (links.next != NoRun) b->links[links.next].prev = to;
+    }
+
+    // Slot s, the first of its run, holds an element again
+    void reuse_run_start(block* b, uint16_t s) {
+        auto length = b->skip[s];
+        b->skip[s] = 0;
+        if (length == 1) {
+            unlink_run(b, s);
+            return;
+        }
+        b->skip[s + 1] = b->skip[s + length - 1] = length - 1;
+        move_run(b, s, s + 1);
+    }
+
+    // Slot i was just emptied, joins it with the runs around it
+    void erase_slot(block* b, size_t i) {
+        auto slot = static_cast<uint16_t>(i);
+        uint16_t left = i > 0 ? b->skip[i - 1] : 0;
+        uint16_t right = i + 1 < b->top ? b->skip[i + 1] : 0;
+        // Inner entries of a run are never read, but must stay non zero to tell erased slots
+        b->skip[i] = 1;
+        if (!left && !right) {
+            push_run(b, slot);
+        } else if (!right) {
+            b->skip[i - left] = b->skip[i] = left + 1;
+        } else if (!left) {
+            b->skip[i] = b->skip[i + right] = right + 1;
+            move_run(b, slot + 1, slot);
+        } else {
+            // The left run stays in the free list, so the block keeps its place in m_with_holes
+            unlink_run(b, slot + 1);
+            b->skip[i - left] = b->skip[i + right] = left + 1 + right;
+        }
+    }
+
+    //
+    // Bidirectional iterator, jumps over runs of erased slots and into the next block
+    //
+    template <bool Const>
+    class hive_iterator {
+        friend class my_hive;
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+    public:
+        hive_iterator() {}
+        hive_iterator(block* block_p, size_t index) : m_block_p(block_p), m_index(index) {}
+        operator hive_iterator<true> () const { return hive_iterator<true>(m_block_p, m_index); }
+        hive_iterator operator ++ (int) { auto result = *this; ++*this; return result; }
+        hive_iterator& operator ++ () {
+            ++m_index;
+            m_index += m_block_p->skip[m_index];
+            if (m_index == m_block_p->top && m_block_p->next) {
+                m_block_p = m_block_p->next;
+                m_index = m_block_p->skip[0];
+            }
+            return *this;
+        }
+        hive_iterator operator -- (int) { auto result = *this; --*this; return result; }
+        hive_iterator& operator -- () {
+            for (;;) {
+                if (m_index == 0) {
+                    m_block_p = m_block_p->prev;
+                    m_index = m_block_p->top;
+                }
+                --m_index;
+                auto length = m_block_p->skip[m_index];
+                if (length == 0) return *this;
+                // The last slot of a run, continue before its first
+                m_index -= length - 1;
+            }
+        }
+        pointer operator -> () const { return m_block_p->slot(m_index); }
+        reference operator * () const { return *m_block_p->slot(m_index); }
+        bool operator == (const hive_iterator& rhs) const { return m_block_p == rhs.m_block_p && m_index == rhs.m_index; }
+        bool operator != (const hive_iterator& rhs) const { return !(*this == rhs); }
+    private:
+        block* m_block_p = nullptr;
+        size_t m_index = 0;
+    };
+
+private:
+    block* m_first = nullptr;
+    block* m_last = nullptr;
+    my_vector<block*> m_with_holes;     // Blocks whose free list is not empty
+    my_vector<block*> m_spares;         // Empty blocks, not in the chain
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+};
+
+}
+
+#endif // MY_HIVE_H
@@ -0,0 +1,121 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_hive.h"
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cpp_training;
+
+namespace {
+
+struct particle {
+    int id;
+    float x;
+};
+
+}
+
+TEST(MyHiveTest, InsertErase) {
+    my_hive<std::string> hive {"a", "b", "c", "d"};
+    EXPECT_EQ(hive.size(), 4);
+    auto it = hive.begin();
+    ++it;
+    const std::string* c = &*std::next(it);
+    it = hive.erase(it);
+    EXPECT_EQ(*it, "c");
+    EXPECT_EQ(c, &*it);
+    EXPECT_EQ(hive.size(), 3);
+
+    // The hole is reused
+    auto e = hive.insert("e");
+    EXPECT_EQ(&*e, c - 1);
+    std::string all;
+    for (auto& s : hive) all += s;
+    EXPECT_EQ(all, "aecd");
+
+    std::string backwards;
+    for (auto i = hive.end(); i != hive.begin();) backwards += *--i;
+    EXPECT_EQ(backwards, "dcea");
+
+    EXPECT_TRUE(hive.get_iterator(c) == std::next(hive.begin(), 2));
+    std::string outside;
+    EXPECT_THROW(hive.get_iterator(&outside), std::invalid_argument);
+
+    my_hive<std::string> copy(hive);
+    auto capacity = hive.capacity();
+    hive.clear();
+    EXPECT_TRUE(hive.is_empty());
+    EXPECT_TRUE(hive.begin() == hive.end());
+    EXPECT_EQ(hive.capacity(), capacity);
+    hive.shrink_to_fit();
+    EXPECT_EQ(hive.capacity(), 0);
+    EXPECT_EQ(copy.size(), 4);
+}
+
+TEST(MyHiveTest, EraseEverything) {
+    my_hive<int> hive;
+    hive.reserve(1000);
+    EXPECT_GE(hive.capacity(), 1000);
+    for (int i = 0; i < 1000; ++i) hive.insert(i);
+    // Every other element, then the rest, merging runs from both sides
+    for (auto it = hive.begin(); it != hive.end();) {
+        it = hive.erase(it);
+        if (it != hive.end()) ++it;
+    }
+    EXPECT_EQ(hive.size(), 500);
+    int expected = 1;
+    for (auto v : hive) {
+        ASSERT_EQ(v, expected);
+        expected += 2;
+    }
+    for (auto it = hive.begin(); it != hive.end();) it = hive.erase(it);
+    EXPECT_TRUE(hive.is_empty());
+    EXPECT_TRUE(hive.begin() == hive.end());
+    hive.insert(7);
+    EXPECT_EQ(*hive.begin(), 7);
+}
+
+TEST(MyHiveTest, ParticleFrames) {
+    my_hive<particle> hive;
+    std::map<int, const particle*> alive;
+    std::mt19937 gen(44);
+    int next_id = 0;
+    for (int i = 0; i < 20000; ++i) {
+        auto it = hive.insert(particle{next_id, 0.0f});
+        alive[next_id++] = &*it;
+    }
+    auto capacity = hive.capacity();
+    for (int frame = 0; frame < 30; ++frame) {
+        // Erase about 5% while iterating, then spawn as many
+        size_t erased = 0;
+        for (auto it = hive.begin(); it != hive.end();) {
+            it->x += 1.0f;
+            if (gen() % 20 == 0) {
+                alive.erase(it->id);
+                it = hive.erase(it);
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+        for (size_t i = 0; i < erased; ++i) {
+            auto it = hive.insert(particle{next_id, 0.0f});
+            alive[next_id++] = &*it;
+        }
+        ASSERT_EQ(hive.size(), alive.size());
+    }
+    // Holes were reused instead of growing
+    EXPECT_EQ(hive.capacity(), capacity);
+
+    // Every particle is where it was inserted, and iteration visits each once
+    for (auto& entry : alive) ASSERT_EQ(entry.second->id, entry.first);
+    std::vector<int> seen;
+    for (auto& p : hive) seen.push_back(p.id);
+    std::sort(seen.begin(), seen.end());
+    ASSERT_EQ(seen.size(), alive.size());
+    auto entry = alive.begin();
+    for (auto id : seen) ASSERT_EQ(id, (entry++)->first);
+}
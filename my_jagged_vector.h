@@ -0,0 +1,200 @@
+#ifndef MY_JAGGED_VECTOR_H
+#define MY_JAGGED_VECTOR_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <initializer_list>
+#include "my_vector.h"
+#include "my_parallel.h"
+#include "my_span.h"
+
+namespace cpp_training {
+
+// Vector of variable length rows in compressed sparse row (CSR) layout: the values of all rows are stored
+// back to back in one my_vector, row r is [offsets[r], offsets[r + 1]) of it.
+// Two allocations in total instead of one per row, and rows which are used together sit together in memory.
+// Only the last row can grow, rows are accessed as my_span.
+template <typename T>
+class my_jagged_vector {
+public:
+    using value_type = T;
+    using row_type = my_span<T>;
+    using const_row_type = my_span<const T>;
+
+public:
+
+    my_jagged_vector() : m_offsets{0} {
+    }
+
+    my_jagged_vector(std::initializer_list<std::initializer_list<T>> rows) : my_jagged_vector() {
+        for (auto& row : rows) push_row(row);
+    }
+
+    // Flattens a vector of vectors
+    explicit my_jagged_vector(const my_vector<my_vector<T>>& rows) : my_jagged_vector() {
+        size_t total = 0;
+        for (auto& row : rows) total += row.size();
+        reserve(rows.size(), total);
+        for (auto& row : rows) push_row(row);
+    }
+
+    size_t row_count() const { return m_offsets.size() - 1; }
+
+    // Number of values in all rows
+    size_t value_count() const { return m_values.size(); }
+
+    bool is_empty() const { return row_count() == 0; }
+
+    size_t row_size(size_t r) const { return m_offsets[r + 1] - m_offsets[r]; }
+
+    row_type operator [] (size_t r) {
+        return row_type(m_values.data() + m_offsets[r], row_size(r));
+    }
+
+    const_row_type operator [] (size_t r) const {
+        return const_row_type(m_values.data() + m_offsets[r], row_size(r));
+    }
+
+    row_type at(size_t r) {
+        if (r >= row_count()) throw std::out_of_range("row is out of range");
+        return (*this)[r];
+    }
+
+    const_row_type at(size_t r) const {
+        if (r >= row_count()) throw std::out_of_range("row is out of range");
+        return (*this)[r];
+    }
+
+    row_type back() { return (*this)[row_count() - 1]; }
+
+    const_row_type back() const { return (*this)[row_count() - 1]; }
+
+    // All values, row after row
+    row_type values() { return row_type(m_values.data(), m_values.size()); }
+
+    const_row_type values() const { return const_row_type(m_values.data(), m_values.size()); }
+
+    // row_count() + 1 offsets into values(), the last one is value_count()
+    const my_vector<size_t>& offsets() const { return m_offsets; }
+
+    void reserve(size_t rows, size_t values) {
+        m_offsets.reserve(rows + 1);
+        m_values.reserve(values);
+    }
+
+    // Adds an empty row
+    void push_row() {
+        m_offsets.push_back(m_values.size());
+    }
+
+    // row may be a row of this vector
+    void push_row(const_row_type row) {
+        append_values(row);
+        m_offsets.push_back(m_values.size());
+    }
+
+    void push_row(const my_vector<T>& row) {
+        push_row(const_row_type(row.data(), row.size()));
+    }
+
+    void push_row(std::initializer_list<T> row) {
+        push_row(const_row_type(row.begin(), row.size()));
+    }
+
+    // Grows the last row, there must be one. value may be in this vector
+    void append_to_last_row(const T& value) {
+        append_to_last_row(const_row_type(&value, 1));
+    }
+
+    template< class... Args >
+    void emplace_to_last_row( Args&&... args ) {
+        m_values.emplace_back(std::forward<Args>(args)...);
+        ++m_offsets.back();
+    }
+
+    void append_to_last_row(const_row_type values) {
+        append_values(values);
+        m_offsets.back() += values.size();
+    }
+
+    void pop_row() {
+        if (!is_empty()) {
+            m_offsets.pop_back();
+            m_values.resize(m_offsets.back());
+        }
+    }
+
+    void clear() {
+        m_values.clear();
+        m_offsets.resize(1);
+    }
+
+    // Calls fn(size_t row, my_span<T> values) for every row. Rows are split between threads by their
+    // number of values, so a few long rows don't leave the other threads idle; fn must be thread safe
+    template <typename Fn>
+    void for_each_row(Fn&& fn, const parallel_policy& policy = par) {
+        for_each_row_of(*this, fn, policy);
+    }
+
+    template <typename Fn>
+    void for_each_row(Fn&& fn, const parallel_policy& policy = par) const {
+        for_each_row_of(*this, fn, policy);
+    }
+
+    // Unpacks into one my_vector per row
+    my_vector<my_vector<T>> to_nested() const {
+        my_vector<my_vector<T>> result;
+        result.reserve(row_count());
+        for (size_t r = 0; r < row_count(); ++r) {
+            auto row = (*this)[r];
+            result.push_back(my_vector<T>(row.begin(), row.end()));
+        }
+        return result;
+    }
+
+    bool operator == (const my_jagged_vector& rhs) const {
+        return m_offsets == rhs.m_offsets && m_values == rhs.m_values;
+    }
+
+    bool operator != (const my_jagged_vector& rhs) const { return !(*this == rhs); }
+
+private:
+    // Copies values to the end of m_values. They may point into m_values, then they are found again after reserve()
+    void append_values(const_row_type values) {
+        const T* source = values.data();
+        const T* old_data = m_values.data();
+        std::less<const T*> less;
+        bool aliased = !less(source, old_data) && less(source, old_data + m_values.size());
+        auto offset = aliased ? source - old_data : 0;
+        auto new_size = m_values.size() + values.size();
+        if (new_size > m_values.capacity()) {
+            // Geometric growth, rows are often pushed one value at a time
+            m_values.reserve(std::max(new_size, static_cast<size_t>(m_values.capacity() * my_vector<T>::CapacityFactor)));
+        }
+        if (aliased) source = m_values.data() + offset;
+        for (size_t i = 0; i < values.size(); ++i) m_values.push_back(source[i]);
+    }
+
+    template <typename Self, typename Fn>
+    static void for_each_row_of(Self& self, Fn& fn, const parallel_policy& policy) {
+        auto row_starts = self.m_offsets.data();
+        auto rows = self.row_count();
+        auto total = self.m_values.size();
+        // A chunk of values takes the rows starting in it, the last chunk also the empty rows at the end
+        detail::parallel_for(policy, total, [&](size_t first, size_t last) {
+            auto r = static_cast<size_t>(std::lower_bound(row_starts, row_starts + rows, first) - row_starts);
+            auto r_end = last == total ? rows
+                                       : static_cast<size_t>(std::lower_bound(row_starts, row_starts + rows, last) - row_starts);
+            for (; r < r_end; ++r) fn(r, self[r]);
+        });
+    }
+
+private:
+    my_vector<T> m_values;
+    my_vector<size_t> m_offsets;
+};
+
+}
+
+#endif // MY_JAGGED_VECTOR_H
@@ -0,0 +1,111 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_jagged_vector.h"
+#include <atomic>
+#include <numeric>
+#include <string>
+
+using namespace cpp_training;
+
+TEST(MyJaggedVectorTest, Rows) {
+    my_jagged_vector<int> jagged {{1, 2, 3}, {}, {4}};
+    EXPECT_EQ(jagged.row_count(), 3);
+    EXPECT_EQ(jagged.value_count(), 4);
+    EXPECT_EQ(jagged.row_size(1), 0);
+    EXPECT_EQ(jagged[0][2], 3);
+    EXPECT_EQ(jagged.back().front(), 4);
+    EXPECT_THROW(jagged.at(3), std::out_of_range);
+    EXPECT_EQ(jagged.offsets(), (my_vector<size_t>{0, 3, 3, 4}));
+
+    jagged[0][0] = 10;
+    EXPECT_EQ(jagged.values()[0], 10);
+
+    jagged.push_row();
+    jagged.append_to_last_row(5);
+    jagged.emplace_to_last_row(6);
+    my_vector<int> more {7, 8};
+    jagged.append_to_last_row(my_span<const int>(more.data(), more.size()));
+    EXPECT_EQ(jagged.row_size(3), 4);
+    EXPECT_EQ(jagged[3].back(), 8);
+
+    jagged.pop_row();
+    EXPECT_EQ(jagged.row_count(), 3);
+    EXPECT_EQ(jagged.value_count(), 4);
+    jagged.clear();
+    EXPECT_TRUE(jagged.is_empty());
+    EXPECT_EQ(jagged.value_count(), 0);
+}
+
+TEST(MyJaggedVectorTest, Nested) {
+    my_vector<my_vector<std::string>> nested;
+    nested.push_back(my_vector<std::string>{"a", "b"});
+    nested.push_back(my_vector<std::string>{});
+    nested.push_back(my_vector<std::string>{"c"});
+    my_jagged_vector<std::string> jagged(nested);
+    EXPECT_EQ(jagged.row_count(), 3);
+    EXPECT_EQ(jagged[2][0], "c");
+    EXPECT_EQ(jagged.to_nested(), nested);
+
+    my_jagged_vector<std::string> copy;
+    for (size_t r = 0; r < jagged.row_count(); ++r) copy.push_row(jagged[r]);
+    EXPECT_EQ(copy, jagged);
+}
+
+TEST(MyJaggedVectorTest, PushOwnRows) {
+    // Every push below outgrows the values, the source rows must be read after the reallocation
+    my_jagged_vector<std::string> jagged {{"a long enough string to live on the heap", "b"}};
+    for (int i = 0; i < 6; ++i) jagged.push_row(jagged[0]);
+    EXPECT_EQ(jagged.row_count(), 7);
+    EXPECT_EQ(jagged.back()[0], "a long enough string to live on the heap");
+    EXPECT_EQ(jagged.back()[1], "b");
+
+    jagged.push_row({"c"});
+    for (int i = 0; i < 6; ++i) jagged.append_to_last_row(jagged[0]);
+    jagged.append_to_last_row(jagged[0][0]);
+    EXPECT_EQ(jagged.row_size(7), 14);
+    EXPECT_EQ(jagged[7][1], "a long enough string to live on the heap");
+    EXPECT_EQ(jagged[7][12], "b");
+    EXPECT_EQ(jagged[7][13], "a long enough string to live on the heap");
+}
+
+TEST(MyJaggedVectorTest, ParallelRows) {
+    // Skewed rows: a few long ones, many short and empty ones at both ends
+    my_jagged_vector<int> jagged;
+    jagged.push_row();
+    for (int r = 0; r < 20000; ++r) {
+        jagged.push_row();
+        auto length = r % 1000 == 0 ? 50000 : r % 5;
+        for (int i = 0; i < length; ++i) jagged.append_to_last_row(r);
+    }
+    jagged.push_row();
+
+    my_vector<int> visits(jagged.row_count(), 0);
+    std::atomic<size_t> values {0};
+    jagged.for_each_row([&](size_t r, my_span<int> row) {
+        ++visits[r];
+        values += row.size();
+        for (auto& value : row) value += 1;
+    }, parallel_policy{8});
+    EXPECT_EQ(values.load(), jagged.value_count());
+    for (size_t r = 0; r < visits.size(); ++r) {
+        ASSERT_EQ(visits[r], 1) << r;
+    }
+    EXPECT_EQ(jagged[1].front(), 1);
+
+    const auto& cjagged = jagged;
+    std::atomic<long long> sum {0};
+    cjagged.for_each_row([&sum](size_t, my_span<const int> row) {
+        sum += std::accumulate(row.begin(), row.end(), 0LL);
+    });
+    long long expected = 0;
+    for (auto value : jagged.values()) expected += value;
+    EXPECT_EQ(sum.load(), expected);
+
+    my_jagged_vector<int> empty_rows;
+    empty_rows.push_row();
+    empty_rows.push_row();
+    size_t seen = 0;
+    empty_rows.for_each_row([&seen](size_t, my_span<int>) { ++seen; });
+    EXPECT_EQ(seen, 2);
+}
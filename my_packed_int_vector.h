@@ -0,0 +1,253 @@
+#ifndef MY_PACKED_INT_VECTOR_H
+#define MY_PACKED_INT_VECTOR_H
+
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+
+// Block layout after FastPFor's bit packing : https://github.com/lemire/FastPFor
+// (without the patched exceptions of PFor, a block is as wide as its widest value)
+
+namespace cpp_training {
+
+// How the values of a block are turned into small non negative offsets before packing
+enum class int_packing {
+    frame_of_reference,     // value - minimum of the block, for clustered values
+    delta                   // difference to the previous value - minimum difference, for sorted or slowly changing values
+};
+
+// Append only vector of integers compressed in blocks of 128 values.
+// Every block stores its offsets with the bit width of the largest one, 2 * width words of 64 bits,
+// so ids below 2^20 take 20 bits instead of 64. The last, incomplete block stays unpacked until it fills up.
+//
+// Random access decodes a single value (a whole block prefix for int_packing::delta),
+// scans should decode block by block with decode_block() or for_each_block().
+template <typename T>
+class my_packed_int_vector {
+    static_assert(std::is_integral<T>::value, "my_packed_int_vector needs an integral type");
+
+    using U = std::make_unsigned_t<T>;
+
+    struct block_header {
+        U base;             // Minimum value (frame_of_reference) or minimum difference (delta)
+        U first;            // First value of the block, delta only
+        size_t word_offset;
+        unsigned width;
+    };
+
+public:
+    static constexpr size_t BlockSize = 128;
+    using value_type = T;
+
+public:
+
+    explicit my_packed_int_vector(int_packing packing = int_packing::frame_of_reference) : m_packing(packing) {
+    }
+
+    explicit my_packed_int_vector(const my_vector<T>& values, int_packing packing = int_packing::frame_of_reference)
+        : m_packing(packing) {
+        append(values);
+    }
+
+    size_t size() const { return m_blocks.size() * BlockSize + m_tail.size(); }
+
+    bool is_empty() const { return size() == 0; }
+
+    int_packing packing() const { return m_packing; }
+
+    // Number of blocks, the last one may be incomplete
+    size_t block_count() const { return m_blocks.size() + !m_tail.is_empty(); }
+
+    // Bytes taken by the packed values, the block headers and the unpacked tail
+    size_t size_in_bytes() const {
+        return m_words.size() * sizeof(uint64_t) + m_blocks.size() * sizeof(block_header) + m_tail.size() * sizeof(T);
+    }
+
+    void push_back(T value) {
+        m_tail.push_back(value);
+        if (m_tail.size() == BlockSize) flush_tail();
+    }
+
+    void append(const T* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) push_back(values[i]);
+    }
+
+    void append(const my_vector<T>& values) {
+        append(values.data(), values.size());
+    }
+
+    void clear() {
+        m_words.clear();
+        m_blocks.clear();
+        m_tail.clear();
+    }
+
+    T operator [] (size_t i) const {
+        auto b = i / BlockSize;
+        if (b == m_blocks.size()) return m_tail[i % BlockSize];
+        auto& header = m_blocks[b];
+        auto words = m_words.data() + header.word_offset;
+        if (m_packing == int_packing::frame_of_reference) {
+            return static_cast<T>(header.base + extract(words, header.width, i % BlockSize));
+        }
+        U value = header.first;
+        for (size_t j = 1; j <= i % BlockSize; ++j) {
+            value += header.base + extract(words, header.width, j);
+        }
+        return static_cast<T>(value);
+    }
+
+    T at(size_t i) const {
+        if (i >= size()) throw std::out_of_range("pos is out of range");
+        return (*this)[i];
+    }
+
+    // Decodes block b into out, which must hold BlockSize values. Returns the number of values in the block
+    size_t decode_block(size_t b, T* out) const {
+        if (b == m_blocks.size()) {
+            std::copy(m_tail.data(), m_tail.data() + m_tail.size(), out);
+            return m_tail.size();
+        }
+        auto& header = m_blocks[b];
+        U* offsets = reinterpret_cast<U*>(out);
+        unpack_table()[header.width](m_words.data() + header.word_offset, offsets);
+        if (m_packing == int_packing::frame_of_reference) {
+            for (size_t i = 0; i < BlockSize; ++i) offsets[i] += header.base;
+        } else {
+            offsets[0] = header.first;
+            for (size_t i = 1; i < BlockSize; ++i) offsets[i] += offsets[i - 1] + header.base;
+        }
+        return BlockSize;
+    }
+
+    // Calls fn(const T* values, size_t count) for every block in order, decoding into one reused buffer
+    template <typename Fn>
+    void for_each_block(Fn&& fn) const {
+        T buffer[BlockSize];
+        for (size_t b = 0; b < block_count(); ++b) {
+            auto count = decode_block(b, buffer);
+            fn(static_cast<const T*>(buffer), count);
+        }
+    }
+
+    // Appends all values to out
+    void decode(my_vector<T>& out) const {
+        out.reserve(out.size() + size());
+        for_each_block([&out](const T* values, size_t count) {
+            for (size_t i = 0; i < count; ++i) out.push_back(values[i]);
+        });
+    }
+
+    my_vector<T> to_vector() const {
+        my_vector<T> result;
+        decode(result);
+        return result;
+    }
+
+private:
+    using unpack_fn = void (*)(const uint64_t*, U*);
+
+    static constexpr size_t MaxWidth = sizeof(U) * 8;
+
+    static U width_mask(unsigned width) {
+        return width == MaxWidth ? U(~U(0)) : U((U(1) << width) - 1);
+    }
+
+    static unsigned bit_width(U value) {
+        unsigned width = 0;
+        for (; value; value >>= 1) ++width;
+        return width;
+    }
+
+    // Offset i of a block packed with width bits per offset
+    static U extract(const uint64_t* words, unsigned width, size_t i) {
+        if (width == 0) return 0;
+        auto bit = i * width;
+        auto word = bit / 64, shift = bit % 64;
+        uint64_t value = words[word] >> shift;
+        if (shift + width > 64) value |= words[word + 1] << (64 - shift);
+        return static_cast<U>(value) & width_mask(width);
+    }
+
+    // Unpacks a whole block, with the width known at compile time the loop is unrolled and the
+    // shifts become constants, which is where the speed of FastPFor's unpackers comes from
+    template <unsigned Width>
+    static void unpack(const uint64_t* words, U* out) {
+        for (size_t i = 0; i < BlockSize; ++i) {
+            if (Width == 0) {
+                out[i] = 0;
+                continue;
+            }
+            const size_t bit = i * Width, word = bit / 64, shift = bit % 64;
+            uint64_t value = words[word] >> shift;
+            if (shift + Width > 64) value |= words[word + 1] << ((64 - shift) % 64);
+            out[i] = static_cast<U>(value) & width_mask(Width);
+        }
+    }
+
+    template <size_t... Widths>
+    static const unpack_fn* make_unpack_table(std::index_sequence<Widths...>) {
+        static const unpack_fn table[] = { &unpack<Widths>... };
+        return table;
+    }
+
+    // Unpacker for every width in [0, MaxWidth]
+    static const unpack_fn* unpack_table() {
+        static const unpack_fn* table = make_unpack_table(std::make_index_sequence<MaxWidth + 1>());
+        return table;
+    }
+
+    // Packs the full tail as a new block
+    void flush_tail() {
+        U offsets[BlockSize];
+        block_header header {};
+        header.word_offset = m_words.size();
+        auto values = reinterpret_cast<const U*>(m_tail.data());
+        if (m_packing == int_packing::frame_of_reference) {
+            header.base = values[0];
+            for (size_t i = 1; i < BlockSize; ++i) {
+                if (static_cast<T>(values[i]) < static_cast<T>(header.base)) header.base = values[i];
+            }
+            for (size_t i = 0; i < BlockSize; ++i) offsets[i] = values[i] - header.base;
+        } else {
+            // Differences are compared as signed, decreasing sequences work too
+            using S = std::make_signed_t<T>;
+            header.first = values[0];
+            header.base = values[1] - values[0];
+            for (size_t i = 2; i < BlockSize; ++i) {
+                U diff = values[i] - values[i - 1];
+                if (static_cast<S>(diff) < static_cast<S>(header.base)) header.base = diff;
+            }
+            offsets[0] = 0;
+            for (size_t i = 1; i < BlockSize; ++i) offsets[i] = values[i] - values[i - 1] - header.base;
+        }
+        U widest = 0;
+        for (size_t i = 0; i < BlockSize; ++i) widest |= offsets[i];
+        header.width = bit_width(widest);
+
+        // A block of 128 offsets of w bits is exactly 2 * w words
+        m_words.resize(m_words.size() + 2 * header.width);
+        auto words = m_words.data() + header.word_offset;
+        for (size_t i = 0; header.width && i < BlockSize; ++i) {
+            auto bit = i * header.width;
+            auto word = bit / 64, shift = bit % 64;
+            words[word] |= static_cast<uint64_t>(offsets[i]) << shift;
+            if (shift + header.width > 64) words[word + 1] |= static_cast<uint64_t>(offsets[i]) >> (64 - shift);
+        }
+        m_blocks.push_back(header);
+        m_tail.clear();
+    }
+
+private:
+    my_vector<uint64_t> m_words;
+    my_vector<block_header> m_blocks;
+    my_vector<T> m_tail;
+    int_packing m_packing;
+};
+
+}
+
+#endif // MY_PACKED_INT_VECTOR_H
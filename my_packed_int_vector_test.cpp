@@ -0,0 +1,95 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_packed_int_vector.h"
+#include <algorithm>
+#include <random>
+
+using namespace cpp_training;
+
+namespace {
+
+template <typename T>
+void check_round_trip(const my_vector<T>& values, int_packing packing) {
+    my_packed_int_vector<T> packed(values, packing);
+    ASSERT_EQ(packed.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(packed[i], values[i]) << "at " << i;
+    }
+    EXPECT_EQ(packed.to_vector(), values);
+}
+
+}
+
+TEST(MyPackedIntVectorTest, SmallIdsTakeTheirWidth) {
+    std::mt19937_64 gen(1);
+    my_vector<uint64_t> ids;
+    for (int i = 0; i < 128 * 100; ++i) ids.push_back(gen() % (1 << 20));
+    my_packed_int_vector<uint64_t> packed(ids);
+    EXPECT_EQ(packed.block_count(), 100);
+    // 20 bits per id plus a 32 byte header per block (2 bits per id) instead of 64 bits
+    EXPECT_LT(packed.size_in_bytes() * 2.5, ids.size() * sizeof(uint64_t));
+    check_round_trip(ids, int_packing::frame_of_reference);
+}
+
+TEST(MyPackedIntVectorTest, AllWidths) {
+    std::mt19937_64 gen(2);
+    for (unsigned width = 0; width <= 64; ++width) {
+        my_vector<uint64_t> values;
+        for (int i = 0; i < 300; ++i) {
+            auto value = width == 64 ? gen() : gen() & ((uint64_t(1) << width) - 1);
+            values.push_back(value + 1000);
+        }
+        check_round_trip(values, int_packing::frame_of_reference);
+        check_round_trip(values, int_packing::delta);
+    }
+}
+
+TEST(MyPackedIntVectorTest, DeltaOnSortedValues) {
+    my_vector<uint64_t> sorted;
+    uint64_t value = uint64_t(1) << 40;
+    std::mt19937 gen(3);
+    for (int i = 0; i < 1000; ++i) sorted.push_back(value += gen() % 16);
+    my_packed_int_vector<uint64_t> by_delta(sorted, int_packing::delta);
+    my_packed_int_vector<uint64_t> by_frame(sorted, int_packing::frame_of_reference);
+    EXPECT_LT(by_delta.size_in_bytes(), by_frame.size_in_bytes());
+    check_round_trip(sorted, int_packing::delta);
+}
+
+TEST(MyPackedIntVectorTest, SignedAndNarrowTypes) {
+    my_vector<int32_t> mixed;
+    for (int i = 0; i < 500; ++i) mixed.push_back((i % 7 - 3) * 100000 + (i % 2 ? INT32_MIN / 2 : 0));
+    check_round_trip(mixed, int_packing::frame_of_reference);
+    check_round_trip(mixed, int_packing::delta);
+
+    my_vector<int8_t> bytes;
+    for (int i = 0; i < 400; ++i) bytes.push_back(static_cast<int8_t>(i * 37));
+    check_round_trip(bytes, int_packing::frame_of_reference);
+    check_round_trip(bytes, int_packing::delta);
+}
+
+TEST(MyPackedIntVectorTest, AppendAndBlocks) {
+    my_packed_int_vector<uint32_t> packed;
+    EXPECT_TRUE(packed.is_empty());
+    EXPECT_THROW(packed.at(0), std::out_of_range);
+    for (uint32_t i = 0; i < 300; ++i) packed.push_back(i * 3);
+    EXPECT_EQ(packed.block_count(), 3);
+    EXPECT_EQ(packed.at(299), 897);
+
+    uint64_t sum = 0;
+    size_t seen = 0;
+    packed.for_each_block([&](const uint32_t* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) sum += values[i];
+        seen += count;
+    });
+    EXPECT_EQ(seen, 300);
+    EXPECT_EQ(sum, 3 * 299 * 300 / 2);
+
+    uint32_t block[my_packed_int_vector<uint32_t>::BlockSize];
+    EXPECT_EQ(packed.decode_block(1, block), 128);
+    EXPECT_EQ(block[0], 384);
+    EXPECT_EQ(packed.decode_block(2, block), 44);
+
+    packed.clear();
+    EXPECT_EQ(packed.size(), 0);
+}
@@ -0,0 +1,134 @@
+#ifndef MY_PARALLEL_H
+#define MY_PARALLEL_H
+
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <new>
+#include <cstddef>
+
+// Execution policies, modelled after https://en.cppreference.com/w/cpp/algorithm/execution_policy_tag_t
+// The standard ones can't be used here: libstdc++ silently runs them sequentially without TBB.
+
+namespace cpp_training {
+
+struct sequenced_policy {
+};
+
+struct parallel_policy {
+    // Number of worker threads, 0 means std::thread::hardware_concurrency()
+    size_t threads = 0;
+};
+
+inline constexpr sequenced_policy seq {};
+inline constexpr parallel_policy par {};
+
+// Assumed size of a cache line, data written by different threads is kept this far apart
+constexpr size_t CacheLineSize = 64;
+
+namespace detail {
+
+// Chunks smaller than this are not worth a thread of their own
+constexpr size_t ParallelMinChunk = 1 << 15;
+
+inline size_t parallel_chunk_count(const parallel_policy& policy, size_t count, size_t min_chunk = ParallelMinChunk) {
+    size_t threads = policy.threads ? policy.threads : std::thread::hardware_concurrency();
+    size_t by_size = min_chunk ? count / min_chunk : count;
+    return std::max<size_t>(1, std::min(threads, by_size));
+}
+
+// Splits [0, count) into contiguous chunks and calls fn(chunk, first, last) for every chunk on its own thread.
+// The calling thread takes the first chunk. Returns the number of chunks; exceptions are reported per chunk in errors,
+// which must be able to hold parallel_chunk_count() entries.
+template <typename Fn>
+size_t parallel_chunks(const parallel_policy& policy, size_t count, std::exception_ptr* errors, Fn&& fn,
+                       size_t min_chunk = ParallelMinChunk) {
+    const size_t chunks = parallel_chunk_count(policy, count, min_chunk);
+    auto run = [&](size_t chunk) {
+        try {
+            fn(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    if (chunks == 1) {
+        run(0);
+        return 1;
+    }
+    std::thread* workers = static_cast<std::thread*>(::operator new ((chunks - 1) * sizeof(std::thread)));
+    size_t started = 0;
+    try {
+        for (; started < chunks - 1; ++started) {
+            new (workers + started) std::thread(run, started + 1);
+        }
+    } catch (...) {
+        // Could not spawn a thread, process the rest of the chunks here
+        for (size_t chunk = started + 1; chunk < chunks; ++chunk) {
+            run(chunk);
+        }
+    }
+    run(0);
+    for (size_t i = 0; i < started; ++i) {
+        workers[i].join();
+        workers[i].~thread();
+    }
+    ::operator delete (workers);
+    return chunks;
+}
+
+// Calls fn(first, last) on contiguous chunks of [0, count) in parallel, rethrows the first exception
+template <typename Fn>
+void parallel_for(const parallel_policy& policy, size_t count, Fn&& fn, size_t min_chunk = ParallelMinChunk) {
+    const size_t chunks = parallel_chunk_count(policy, count, min_chunk);
+    std::exception_ptr* errors = new std::exception_ptr[chunks];
+    parallel_chunks(policy, count, errors, [&fn](size_t, size_t first, size_t last) { fn(first, last); }, min_chunk);
+    std::exception_ptr error;
+    for (size_t i = 0; i < chunks && !error; ++i) {
+        error = errors[i];
+    }
+    delete [] errors;
+    if (error) std::rethrow_exception(error);
+}
+
+// Constructs count objects in raw memory at dst in parallel, construct(p, i) must placement-new the i-th object at p.
+// Each thread constructs (and so first touches) its own chunk. If any construction throws,
+// everything constructed so far is destroyed and the first exception is rethrown.
+template <typename T, typename Construct>
+void parallel_uninitialized_construct(const parallel_policy& policy, T* dst, size_t count, Construct&& construct) {
+    const size_t chunks = parallel_chunk_count(policy, count);
+    std::exception_ptr* errors = new std::exception_ptr[chunks];
+    parallel_chunks(policy, count, errors, [&](size_t, size_t first, size_t last) {
+        size_t i = first;
+        try {
+            for (; i < last; ++i) {
+                construct(dst + i, i);
+            }
+        } catch (...) {
+            while (i != first) {
+                dst[--i].~T();
+            }
+            throw;
+        }
+    });
+    std::exception_ptr error;
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        if (errors[chunk] && !error) error = errors[chunk];
+    }
+    if (error) {
+        // Roll back the chunks which succeeded
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            if (errors[chunk]) continue;
+            for (size_t i = count * chunk / chunks; i < count * (chunk + 1) / chunks; ++i) {
+                dst[i].~T();
+            }
+        }
+    }
+    delete [] errors;
+    if (error) std::rethrow_exception(error);
+}
+
+}
+
+}
+
+#endif // MY_PARALLEL_H
@@ -0,0 +1,417 @@
+#ifndef MY_PERSISTENT_VECTOR_H
+#define MY_PERSISTENT_VECTOR_H
+
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include "my_vector.h"
+
+namespace cpp_training {
+
+// Persistent (immutable) vector.
+// Every modification returns a new version which shares all untouched nodes with the old one,
+// so any number of historical versions can be kept at O(log32 n) memory cost per modification.
+//
+// The tree is a relaxed radix balanced tree: every internal node keeps a table of the cumulative sizes
+// of its children, so subtrees do not have to be full: concat is O(log n), and slice is O(log^2 n),
+// since a split joins the pieces back together on every level it descends.
+// All leaves are at the same depth, and every node except the root has at least Branching/2 entries,
+// which keeps the depth within log16(n) + 1.
+//
+// Nodes are reference counted with std::shared_ptr, versions can be shared between threads freely.
+template <typename T>
+class my_persistent_vector {
+public:
+    static constexpr size_t Branching = 32;
+
+private:
+    static constexpr size_t MinFill = Branching / 2;
+
+    struct node;
+    using node_ptr = std::shared_ptr<const node>;
+
+    struct node {
+        my_vector<T> values;            // Elements, leaves only
+        my_vector<node_ptr> children;   // Internal nodes only
+        my_vector<size_t> sizes;        // Cumulative sizes of the children, internal nodes only
+    };
+
+    struct tree {
+        node_ptr root;
+        size_t height = 0;              // 0 when the root is a leaf
+    };
+
+public:
+    using value_type = T;
+    using const_reference = const T&;
+
+    // Batch-mutable version of the vector, used for bulk building and updates.
+    // Nodes owned by the transient only are updated in place, appended elements are buffered
+    // and inserted as whole subtrees. Not thread safe.
+    class transient_type {
+        friend class my_persistent_vector;
+    public:
+        size_t size() const {
+            return size_of(m_tree) + m_tail.size();
+        }
+
+        const T& operator [] (size_t i) const {
+            auto tree_size = size_of(m_tree);
+            return i < tree_size ? get(m_tree, i) : m_tail[i - tree_size];
+        }
+
+        void push_back(const T& value) {
+            m_tail.push_back(value);
+            if (m_tail.size() == Branching * Branching) flush();
+        }
+
+        void push_back(T&& value) {
+            m_tail.push_back(std::move(value));
+            if (m_tail.size() == Branching * Branching) flush();
+        }
+
+        void append(const my_vector<T>& values) {
+            flush();
+            m_tree = join(m_tree, build(values, 0, values.size()));
+        }
+
+        void set(size_t pos, const T& value) {
+            auto tree_size = size_of(m_tree);
+            if (pos >= tree_size + m_tail.size()) throw std::out_of_range("pos is out of range");
+            if (pos < tree_size) {
+                set_in_place(m_tree.root, m_tree.height, pos, value);
+            } else {
+                m_tail[pos - tree_size] = value;
+            }
+        }
+
+        // Returns the result as a persistent vector, the transient is empty afterwards
+        my_persistent_vector persistent() {
+            flush();
+            my_persistent_vector result(m_tree);
+            m_tree = tree{};
+            return result;
+        }
+
+    private:
+        explicit transient_type(const tree& t) : m_tree(t) {}
+
+        void flush() {
+            if (m_tail.is_empty()) return;
+            m_tree = join(m_tree, build(m_tail, 0, m_tail.size()));
+            m_tail.clear();
+        }
+
+        // Path copying which reuses the nodes nobody else refers to
+        static void set_in_place(node_ptr& n, size_t height, size_t i, const T& value) {
+            if (n.use_count() != 1) {
+                n = std::make_shared<node>(*n);
+            }
+            // Every node is created non-const, so modifying an unshared one is fine
+            auto mutable_p = const_cast<node*>(n.get());
+            if (height == 0) {
+                mutable_p->values[i] = value;
+                return;
+            }
+            auto c = child_index(*n, i);
+            set_in_place(mutable_p->children[c], height - 1, i - child_offset(*n, c), value);
+        }
+
+    private:
+        tree m_tree;
+        my_vector<T> m_tail;
+    };
+
+public:
+
+    my_persistent_vector() {
+    }
+
+    // Bulk construction, O(n)
+    explicit my_persistent_vector(const my_vector<T>& values)
+        : m_tree(build(values, 0, values.size())) {
+    }
+
+    my_persistent_vector(std::initializer_list<T> lst)
+        : my_persistent_vector(my_vector<T>(lst)) {
+    }
+
+    size_t size() const {
+        return size_of(m_tree);
+    }
+
+    bool is_empty() const {
+        return !m_tree.root;
+    }
+
+    const T& operator [] (size_t i) const {
+        return get(m_tree, i);
+    }
+
+    const T& at (size_t pos) const {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        return get(m_tree, pos);
+    }
+
+    const T& front() const {
+        return get(m_tree, 0);
+    }
+
+    const T& back() const {
+        return get(m_tree, size() - 1);
+    }
+
+    // Returns a new version with value appended, O(log n)
+    my_persistent_vector push_back(const T& value) const {
+        my_vector<T> leaf_values {value};
+        return my_persistent_vector(join(m_tree, build(leaf_values, 0, 1)));
+    }
+
+    // Returns a new version with element at pos replaced, O(log n)
+    my_persistent_vector set(size_t pos, const T& value) const {
+        if (pos >= size()) throw std::out_of_range("pos is out of range");
+        return my_persistent_vector(tree{set_in(m_tree.root, m_tree.height, pos, value), m_tree.height});
+    }
+
+    // Returns a new version holding elements [first, last), O(log^2 n)
+    my_persistent_vector slice(size_t first, size_t last) const {
+        if (first > last || last > size()) throw std::out_of_range("slice is out of range");
+        auto head = split(m_tree.root, m_tree.height, last).first;
+        return my_persistent_vector(split(head.root, head.height, first).second);
+    }
+
+    // Returns a new version holding elements of this followed by elements of rhs, O(log n)
+    my_persistent_vector concat(const my_persistent_vector& rhs) const {
+        return my_persistent_vector(join(m_tree, rhs.m_tree));
+    }
+
+    transient_type transient() const {
+        return transient_type(m_tree);
+    }
+
+    // Calls fn for every element in order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        if (m_tree.root) for_each_in(*m_tree.root, m_tree.height, fn);
+    }
+
+    my_vector<T> to_vector() const {
+        my_vector<T> result;
+        result.reserve(size());
+        for_each([&result](const T& value) { result.push_back(value); });
+        return result;
+    }
+
+private:
+    explicit my_persistent_vector(const tree& t) : m_tree(t) {}
+
+    static size_t count_of(const node& n, size_t height) {
+        return height ? n.children.size() : n.values.size();
+    }
+
+    static size_t size_of(const node& n, size_t height) {
+        return height ? n.sizes.back() : n.values.size();
+    }
+
+    static size_t size_of(const tree& t) {
+        return t.root ? size_of(*t.root, t.height) : 0;
+    }
+
+    // Index of the child holding element i
+    static size_t child_index(const node& n, size_t i) {
+        size_t c = 0;
+        while (n.sizes[c] <= i) ++c;
+        return c;
+    }
+
+    static size_t child_offset(const node& n, size_t c) {
+        return c ? n.sizes[c - 1] : 0;
+    }
+
+    static const T& get(const tree& t, size_t i) {
+        const node* n = t.root.get();
+        for (size_t h = t.height; h > 0; --h) {
+            auto c = child_index(*n, i);
+            i -= child_offset(*n, c);
+            n = n->children[c].get();
+        }
+        return n->values[i];
+    }
+
+    static node_ptr make_leaf(const my_vector<T>& values, size_t first, size_t count) {
+        auto n = std::make_shared<node>();
+        n->values.reserve(count);
+        for (size_t i = first; i < first + count; ++i) {
+            n->values.push_back(values[i]);
+        }
+        return n;
+    }
+
+    static node_ptr make_internal(const my_vector<node_ptr>& children, size_t first, size_t count, size_t height) {
+        auto n = std::make_shared<node>();
+        n->children.reserve(count);
+        n->sizes.reserve(count);
+        size_t total = 0;
+        for (size_t i = first; i < first + count; ++i) {
+            total += size_of(*children[i], height - 1);
+            n->children.push_back(children[i]);
+            n->sizes.push_back(total);
+        }
+        return n;
+    }
+
+    // Tree from children [first, first + count) of a node of the given height
+    static tree make_tree(const my_vector<node_ptr>& children, size_t first, size_t count, size_t height) {
+        if (count == 0) return tree{};
+        if (count == 1) return tree{children[first], height - 1};
+        return tree{make_internal(children, first, count, height), height};
+    }
+
+    // Builds a tree of values [first, last) bottom up, nodes are filled evenly
+    static tree build(const my_vector<T>& values, size_t first, size_t last) {
+        auto count = last - first;
+        if (count == 0) return tree{};
+        my_vector<node_ptr> level;
+        auto leaves = (count + Branching - 1) / Branching;
+        level.reserve(leaves);
+        for (size_t k = 0; k < leaves; ++k) {
+            auto from = count * k / leaves;
+            level.push_back(make_leaf(values, first + from, count * (k + 1) / leaves - from));
+        }
+        size_t height = 0;
+        while (level.size() > 1) {
+            ++height;
+            level = pack(level, height);
+        }
+        return tree{level[0], height};
+    }
+
+    // Packs nodes of height - 1 evenly into the minimal number of nodes of the given height
+    static my_vector<node_ptr> pack(const my_vector<node_ptr>& nodes, size_t height) {
+        my_vector<node_ptr> result;
+        auto count = nodes.size();
+        auto parts = (count + Branching - 1) / Branching;
+        result.reserve(parts);
+        for (size_t p = 0; p < parts; ++p) {
+            auto from = count * p / parts;
+            result.push_back(make_internal(nodes, from, count * (p + 1) / parts - from, height));
+        }
+        return result;
+    }
+
+    // Appends to out one node holding entries of both a and b, or two balanced nodes if they don't fit into one.
+    // Nodes which are filled enough are reused as is.
+    static void merge_nodes(const node_ptr& a, const node_ptr& b, size_t height, my_vector<node_ptr>& out) {
+        if (count_of(*a, height) >= MinFill && count_of(*b, height) >= MinFill) {
+            out.push_back(a);
+            out.push_back(b);
+            return;
+        }
+        if (height == 0) {
+            my_vector<T> values;
+            values.reserve(a->values.size() + b->values.size());
+            for (auto& v : a->values) values.push_back(v);
+            for (auto& v : b->values) values.push_back(v);
+            auto count = values.size();
+            size_t parts = count <= Branching ? 1 : 2;
+            for (size_t p = 0; p < parts; ++p) {
+                auto from = count * p / parts;
+                out.push_back(make_leaf(values, from, count * (p + 1) / parts - from));
+            }
+        } else {
+            my_vector<node_ptr> children;
+            children.reserve(a->children.size() + b->children.size());
+            for (auto& c : a->children) children.push_back(c);
+            for (auto& c : b->children) children.push_back(c);
+            for (auto& n : pack(children, height)) out.push_back(n);
+        }
+    }
+
+    // Joins b to the right spine of a, ha >= hb. Appends to out one or two nodes of height ha.
+    static void join_right(const node_ptr& a, size_t ha, const node_ptr& b, size_t hb, my_vector<node_ptr>& out) {
+        if (ha == hb) {
+            merge_nodes(a, b, ha, out);
+            return;
+        }
+        my_vector<node_ptr> children;
+        children.reserve(a->children.size() + 1);
+        for (size_t i = 0; i + 1 < a->children.size(); ++i) {
+            children.push_back(a->children[i]);
+        }
+        join_right(a->children.back(), ha - 1, b, hb, children);
+        for (auto& n : pack(children, ha)) out.push_back(n);
+    }
+
+    // Joins a to the left spine of b, ha < hb. Appends to out one or two nodes of height hb.
+    static void join_left(const node_ptr& a, size_t ha, const node_ptr& b, size_t hb, my_vector<node_ptr>& out) {
+        if (ha == hb) {
+            merge_nodes(a, b, hb, out);
+            return;
+        }
+        my_vector<node_ptr> children;
+        children.reserve(b->children.size() + 1);
+        join_left(a, ha, b->children.front(), hb - 1, children);
+        for (size_t i = 1; i < b->children.size(); ++i) {
+            children.push_back(b->children[i]);
+        }
+        for (auto& n : pack(children, hb)) out.push_back(n);
+    }
+
+    static tree join(const tree& a, const tree& b) {
+        if (!a.root) return b;
+        if (!b.root) return a;
+        my_vector<node_ptr> nodes;
+        auto height = std::max(a.height, b.height);
+        if (a.height >= b.height) {
+            join_right(a.root, a.height, b.root, b.height, nodes);
+        } else {
+            join_left(a.root, a.height, b.root, b.height, nodes);
+        }
+        if (nodes.size() == 1) return tree{nodes[0], height};
+        return tree{make_internal(nodes, 0, nodes.size(), height + 1), height + 1};
+    }
+
+    // Splits the subtree at n into elements [0, i) and [i, size)
+    static std::pair<tree, tree> split(const node_ptr& n, size_t height, size_t i) {
+        if (!n || i == 0) return {tree{}, tree{n, height}};
+        auto total = size_of(*n, height);
+        if (i >= total) return {tree{n, height}, tree{}};
+        if (height == 0) {
+            return {tree{make_leaf(n->values, 0, i), 0}, tree{make_leaf(n->values, i, total - i), 0}};
+        }
+        auto c = child_index(*n, i);
+        auto parts = split(n->children[c], height - 1, i - child_offset(*n, c));
+        auto prefix = make_tree(n->children, 0, c, height);
+        auto suffix = make_tree(n->children, c + 1, n->children.size() - c - 1, height);
+        return {join(prefix, parts.first), join(parts.second, suffix)};
+    }
+
+    static node_ptr set_in(const node_ptr& n, size_t height, size_t i, const T& value) {
+        auto copy = std::make_shared<node>(*n);
+        if (height == 0) {
+            copy->values[i] = value;
+        } else {
+            auto c = child_index(*n, i);
+            copy->children[c] = set_in(n->children[c], height - 1, i - child_offset(*n, c), value);
+        }
+        return copy;
+    }
+
+    template <typename Fn>
+    static void for_each_in(const node& n, size_t height, Fn& fn) {
+        if (height == 0) {
+            for (auto& v : n.values) fn(v);
+        } else {
+            for (auto& c : n.children) for_each_in(*c, height - 1, fn);
+        }
+    }
+
+private:
+    tree m_tree;
+};
+
+}
+
+#endif // MY_PERSISTENT_VECTOR_H
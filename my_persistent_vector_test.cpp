@@ -0,0 +1,163 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_persistent_vector.h"
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cpp_training;
+
+template <typename T>
+static std::vector<T> to_std(const my_persistent_vector<T>& vec) {
+    std::vector<T> result;
+    vec.for_each([&result](const T& v) { result.push_back(v); });
+    return result;
+}
+
+TEST(MyPersistentVectorTest, Construction) {
+    my_persistent_vector<int> empty;
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_THROW(empty.at(0), std::out_of_range);
+
+    my_persistent_vector<std::string> strs {"a", "b", "c"};
+    EXPECT_EQ(strs.size(), 3);
+    EXPECT_EQ(strs[1], "b");
+    EXPECT_EQ(strs.front(), "a");
+    EXPECT_EQ(strs.back(), "c");
+
+    my_vector<int> src(10000);
+    std::iota(src.begin(), src.end(), 0);
+    my_persistent_vector<int> big(src);
+    EXPECT_EQ(big.size(), 10000);
+    EXPECT_EQ(big.to_vector(), src);
+    for (size_t i = 0; i < src.size(); i += 97) {
+        EXPECT_EQ(big[i], src[i]);
+    }
+}
+
+TEST(MyPersistentVectorTest, VersionsAreIndependent) {
+    my_persistent_vector<int> v0;
+    my_vector<my_persistent_vector<int>> history;
+    for (int i = 0; i < 3000; ++i) {
+        history.push_back(v0);
+        v0 = v0.push_back(i);
+    }
+    EXPECT_EQ(v0.size(), 3000);
+    for (size_t i = 0; i < history.size(); i += 101) {
+        EXPECT_EQ(history[i].size(), i);
+        if (i) {
+            EXPECT_EQ(history[i].back(), i - 1);
+        }
+    }
+
+    auto v1 = v0.set(1500, -1);
+    EXPECT_EQ(v1[1500], -1);
+    EXPECT_EQ(v0[1500], 1500);
+    EXPECT_EQ(v1[1499], 1499);
+    EXPECT_THROW(v0.set(3000, 1), std::out_of_range);
+}
+
+TEST(MyPersistentVectorTest, SliceConcat) {
+    my_vector<int> src(5000);
+    std::iota(src.begin(), src.end(), 0);
+    my_persistent_vector<int> vec(src);
+
+    auto mid = vec.slice(1000, 3500);
+    EXPECT_EQ(mid.size(), 2500);
+    EXPECT_EQ(mid.front(), 1000);
+    EXPECT_EQ(mid.back(), 3499);
+
+    auto joined = vec.slice(0, 1000).concat(vec.slice(1000, 5000));
+    EXPECT_EQ(joined.to_vector(), src);
+
+    EXPECT_TRUE(vec.slice(10, 10).is_empty());
+    EXPECT_EQ(vec.slice(0, 5000).size(), 5000);
+    EXPECT_THROW(vec.slice(10, 5), std::out_of_range);
+    EXPECT_THROW(vec.slice(0, 5001), std::out_of_range);
+
+    my_persistent_vector<int> small {1, 2};
+    auto mixed = small.concat(vec).concat(small);
+    EXPECT_EQ(mixed.size(), 5004);
+    EXPECT_EQ(mixed[0], 1);
+    EXPECT_EQ(mixed[2], 0);
+    EXPECT_EQ(mixed[5003], 2);
+}
+
+TEST(MyPersistentVectorTest, RandomOperations) {
+    std::mt19937 rng(42);
+    my_persistent_vector<int> vec;
+    std::vector<int> model;
+    int next = 0;
+    for (int step = 0; step < 400; ++step) {
+        switch (rng() % 4) {
+        case 0: {
+            auto count = rng() % 300;
+            for (size_t i = 0; i < count; ++i) {
+                vec = vec.push_back(next);
+                model.push_back(next++);
+            }
+            break;
+        }
+        case 1:
+            if (!model.empty()) {
+                auto pos = rng() % model.size();
+                vec = vec.set(pos, -next);
+                model[pos] = -next++;
+            }
+            break;
+        case 2: {
+            auto first = rng() % (model.size() + 1);
+            auto last = first + rng() % (model.size() - first + 1);
+            vec = vec.slice(first, last);
+            model = std::vector<int>(model.begin() + first, model.begin() + last);
+            break;
+        }
+        case 3: {
+            auto other = vec.slice(0, model.size() / 2);
+            std::vector<int> other_model(model.begin(), model.begin() + model.size() / 2);
+            vec = other.concat(vec);
+            model.insert(model.begin(), other_model.begin(), other_model.end());
+            break;
+        }
+        }
+        ASSERT_EQ(vec.size(), model.size());
+        ASSERT_EQ(to_std(vec), model);
+    }
+}
+
+TEST(MyPersistentVectorTest, Transient) {
+    my_persistent_vector<int> base {1, 2, 3};
+    auto tr = base.transient();
+    for (int i = 0; i < 5000; ++i) {
+        tr.push_back(i);
+    }
+    EXPECT_EQ(tr.size(), 5003);
+    EXPECT_EQ(tr[3], 0);
+    EXPECT_EQ(tr[5002], 4999);
+
+    tr.set(0, 100);
+    tr.set(5002, -1);
+    my_vector<int> extra {7, 8};
+    tr.append(extra);
+    EXPECT_THROW(tr.set(5005, 0), std::out_of_range);
+
+    auto result = tr.persistent();
+    EXPECT_EQ(tr.size(), 0);
+    EXPECT_EQ(result.size(), 5005);
+    EXPECT_EQ(result[0], 100);
+    EXPECT_EQ(result[5002], -1);
+    EXPECT_EQ(result[5004], 8);
+
+    // The source version is untouched
+    EXPECT_EQ(base.to_vector(), (my_vector<int>{1, 2, 3}));
+
+    // Nodes shared with other versions are copied, not modified
+    auto tr2 = result.transient();
+    tr2.set(10, 12345);
+    auto result2 = tr2.persistent();
+    EXPECT_EQ(result2[10], 12345);
+    EXPECT_EQ(result[10], 7);
+}
@@ -0,0 +1,352 @@
+#ifndef MY_POLY_VECTOR_H
+#define MY_POLY_VECTOR_H
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <typeinfo>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_span.h"
+
+// Interface after boost::poly_collection : https://www.boost.org/doc/libs/release/doc/html/poly_collection.html
+
+namespace cpp_training {
+
+namespace detail {
+
+// What a segment needs to know about the type it stores
+struct poly_ops {
+    void (*destroy)(void* p);
+    void (*move_construct)(void* dst, void* src);
+    void (*copy_construct)(void* dst, const void* src);
+};
+
+template <typename D>
+const poly_ops* poly_ops_of() {
+    static const poly_ops ops {
+        [](void* p) { static_cast<D*>(p)->~D(); },
+        [](void* dst, void* src) { new (dst) D{ std::move(*static_cast<D*>(src)) }; },
+        [](void* dst, const void* src) {
+            if constexpr (std::is_copy_constructible<D>::value) {
+                new (dst) D{ *static_cast<const D*>(src) };
+            } else {
+                throw std::logic_error("element type is not copy constructible");
+            }
+        }
+    };
+    return &ops;
+}
+
+}
+
+// Sequence of objects derived from Base, stored by value instead of as my_vector<std::unique_ptr<Base>>.
+// Objects are grouped by concrete type in segments, each a contiguous byte arena holding one type at a
+// fixed stride, so there is no allocation and no pointer to chase per element.
+// Order is kept within a segment only. for_each<D1, D2...>(fn) calls fn with the static type
+// for the listed types, which lets the compiler devirtualize (and inline) calls to final classes.
+template <typename Base>
+class my_poly_vector {
+    struct type_segment {
+        const std::type_info* type;
+        const detail::poly_ops* ops;
+        size_t stride;
+        size_t alignment;
+        ptrdiff_t base_offset = 0;      // Of the Base subobject, the same for every object of the type
+        unsigned char* data = nullptr;
+        size_t size = 0;
+        size_t capacity = 0;
+
+        void* raw(size_t i) const { return data + i * stride; }
+
+        Base* at(size_t i) const {
+            return std::launder(reinterpret_cast<Base*>(data + i * stride + base_offset));
+        }
+
+        template <typename D>
+        D* as(size_t i) const { return std::launder(reinterpret_cast<D*>(raw(i))); }
+    };
+
+    template <bool Const>
+    class poly_iterator;
+
+public:
+    static constexpr size_t MinSegmentCapacity = 4;
+    using value_type = Base;
+    using iterator = poly_iterator<false>;
+    using const_iterator = poly_iterator<true>;
+
+public:
+
+    my_poly_vector() {
+    }
+
+    // Delegates, so the destructor cleans up if a copy throws
+    my_poly_vector(const my_poly_vector& rhs) : my_poly_vector() {
+        for (auto s : rhs.m_segments) {
+            auto copy = new type_segment{s->type, s->ops, s->stride, s->alignment, s->base_offset};
+            m_segments.push_back(copy);
+            reallocate(*copy, s->size);
+            for (; copy->size < s->size; ++copy->size) copy->ops->copy_construct(copy->raw(copy->size), s->raw(copy->size));
+            m_size += copy->size;
+        }
+    }
+
+    my_poly_vector(my_poly_vector&& rhs) noexcept {
+        swap(rhs);
+    }
+
+    ~my_poly_vector() noexcept {
+        clear();
+        for (auto s : m_segments) {
+            deallocate(*s);
+            delete s;
+        }
+    }
+
+    my_poly_vector& operator = (const my_poly_vector& rhs) {
+        my_poly_vector tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_poly_vector& operator = (my_poly_vector&& rhs) noexcept {
+        my_poly_vector tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(my_poly_vector& rhs) noexcept {
+        m_segments.swap(rhs.m_segments);
+        std::swap(m_size, rhs.m_size);
+    }
+
+    size_t size() const { return m_size; }
+
+    bool is_empty() const { return m_size == 0; }
+
+    // Number of objects of type D
+    template <typename D>
+    size_t size() const {
+        auto s = find_segment(typeid(D));
+        return s ? s->size : 0;
+    }
+
+    // Number of concrete types seen so far
+    size_t segment_count() const { return m_segments.size(); }
+
+    template <typename D>
+    void reserve(size_t new_cap) {
+        auto& s = segment_for<D>();
+        if (new_cap > s.capacity) reallocate(s, new_cap);
+    }
+
+    // args must not refer to an element of the container
+    template <typename D, class... Args>
+    D& emplace(Args&&... args) {
+        static_assert(std::is_base_of<Base, D>::value, "my_poly_vector stores types derived from Base");
+        auto& s = segment_for<D>();
+        if (s.size == s.capacity) reallocate(s, std::max(s.capacity * 2, MinSegmentCapacity));
+        auto p = new (s.raw(s.size)) D{ std::forward<Args>(args)... };
+        s.base_offset = reinterpret_cast<unsigned char*>(static_cast<Base*>(p)) - reinterpret_cast<unsigned char*>(p);
+        ++s.size;
+        ++m_size;
+        return *p;
+    }
+
+    // Stores a copy of value as its static type D, which must also be its dynamic type:
+    // a derived object passed by a reference to a concrete base would be sliced, that throws.
+    // value may be an element of the container
+    template <typename D>
+    std::decay_t<D>& push_back(D&& value) {
+        using V = std::decay_t<D>;
+        if (typeid(value) != typeid(V)) {
+            throw std::invalid_argument("value would be sliced, its dynamic type is not D");
+        }
+        auto s = find_segment(typeid(V));
+        if (s && s->size == s->capacity) {
+            // The segment is reallocated before the new object is constructed
+            V copy{ std::forward<D>(value) };
+            return emplace<V>(std::move(copy));
+        }
+        return emplace<V>(std::forward<D>(value));
+    }
+
+    // The objects of type D, contiguous
+    template <typename D>
+    my_span<D> segment() {
+        auto s = find_segment(typeid(D));
+        return s ? my_span<D>(s->template as<D>(0), s->size) : my_span<D>();
+    }
+
+    template <typename D>
+    my_span<const D> segment() const {
+        auto s = find_segment(typeid(D));
+        return s ? my_span<const D>(s->template as<D>(0), s->size) : my_span<const D>();
+    }
+
+    // Calls fn(D&) for the objects of the listed types Ds, fn(Base&) for the others, segment by segment
+    template <typename... Ds, typename Fn>
+    void for_each(Fn&& fn) {
+        for (auto s : m_segments) {
+            if (!(visit_as<Ds>(*s, fn) || ...)) {
+                for (size_t i = 0; i < s->size; ++i) fn(*s->at(i));
+            }
+        }
+    }
+
+    template <typename... Ds, typename Fn>
+    void for_each(Fn&& fn) const {
+        for (auto s : m_segments) {
+            if (!(visit_as<const Ds>(*s, fn) || ...)) {
+                for (size_t i = 0; i < s->size; ++i) fn(static_cast<const Base&>(*s->at(i)));
+            }
+        }
+    }
+
+    // Erases the objects for which pred(const Base&) holds, keeping the order of the others. Returns their number.
+    // If pred or a move throws, the objects of the segment from that one on are destroyed too
+    template <typename Pred>
+    size_t erase_if(Pred pred) {
+        size_t erased = 0;
+        for (auto s : m_segments) {
+            size_t kept = 0, i = 0;
+            try {
+                for (; i < s->size; ++i) {
+                    if (pred(static_cast<const Base&>(*s->at(i)))) {
+                        s->ops->destroy(s->raw(i));
+                    } else {
+                        if (kept != i) {
+                            s->ops->move_construct(s->raw(kept), s->raw(i));
+                            s->ops->destroy(s->raw(i));
+                        }
+                        ++kept;
+                    }
+                }
+            } catch (...) {
+                // [kept, i) are destroyed already, the objects after them can't be moved down safely
+                for (; i < s->size; ++i) s->ops->destroy(s->raw(i));
+                m_size -= erased + s->size - kept;
+                s->size = kept;
+                throw;
+            }
+            erased += s->size - kept;
+            s->size = kept;
+        }
+        m_size -= erased;
+        return erased;
+    }
+
+    // Destroys the objects, keeps the segments and their storage
+    void clear() {
+        for (auto s : m_segments) {
+            for (size_t i = 0; i < s->size; ++i) s->ops->destroy(s->raw(i));
+            s->size = 0;
+        }
+        m_size = 0;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0, 0); }
+
+    iterator end() noexcept { return iterator(this, m_segments.size(), 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_segments.size(), 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    type_segment* find_segment(const std::type_info& type) const {
+        for (auto s : m_segments) {
+            if (*s->type == type) return s;
+        }
+        return nullptr;
+    }
+
+    template <typename D>
+    type_segment& segment_for() {
+        if (auto s = find_segment(typeid(D))) return *s;
+        m_segments.reserve(m_segments.size() + 1);
+        m_segments.push_back(new type_segment{&typeid(D), detail::poly_ops_of<D>(), sizeof(D), alignof(D)});
+        return *m_segments.back();
+    }
+
+    // Moves the objects of s into storage for new_cap of them. If a move throws, s keeps its objects
+    static void reallocate(type_segment& s, size_t new_cap) {
+        auto data = static_cast<unsigned char*>(::operator new (new_cap * s.stride, std::align_val_t(s.alignment)));
+        size_t moved = 0;
+        try {
+            for (; moved < s.size; ++moved) s.ops->move_construct(data + moved * s.stride, s.raw(moved));
+        } catch (...) {
+            for (size_t i = 0; i < moved; ++i) s.ops->destroy(data + i * s.stride);
+            ::operator delete (data, std::align_val_t(s.alignment));
+            throw;
+        }
+        for (size_t i = 0; i < s.size; ++i) s.ops->destroy(s.raw(i));
+        deallocate(s);
+        s.data = data;
+        s.capacity = new_cap;
+    }
+
+    static void deallocate(type_segment& s) noexcept {
+        if (s.data) ::operator delete (s.data, std::align_val_t(s.alignment));
+        s.data = nullptr;
+    }
+
+    template <typename D, typename Fn>
+    static bool visit_as(const type_segment& s, Fn& fn) {
+        if (*s.type != typeid(D)) return false;
+        for (size_t i = 0; i < s.size; ++i) fn(*s.template as<D>(i));
+        return true;
+    }
+
+    //
+    // Forward iterator over the objects as Base, segment by segment
+    //
+    template <bool Const>
+    class poly_iterator {
+        using owner_type = std::conditional_t<Const, const my_poly_vector, my_poly_vector>;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Base;
+        using difference_type = ptrdiff_t;
+        using reference = std::conditional_t<Const, const Base&, Base&>;
+        using pointer = std::conditional_t<Const, const Base*, Base*>;
+    public:
+        poly_iterator() {}
+        poly_iterator(owner_type* owner_p, size_t segment, size_t index)
+            : m_owner_p(owner_p), m_segment(segment), m_index(index) { skip_empty(); }
+        operator poly_iterator<true> () const { return poly_iterator<true>(m_owner_p, m_segment, m_index); }
+        poly_iterator operator ++ (int) { auto result = *this; ++*this; return result; }
+        poly_iterator& operator ++ () { ++m_index; skip_empty(); return *this; }
+        pointer operator -> () const { return m_owner_p->m_segments[m_segment]->at(m_index); }
+        reference operator * () const { return *operator->(); }
+        bool operator == (const poly_iterator& rhs) const { return m_segment == rhs.m_segment && m_index == rhs.m_index; }
+        bool operator != (const poly_iterator& rhs) const { return !(*this == rhs); }
+    private:
+        void skip_empty() {
+            auto& segments = m_owner_p->m_segments;
+            while (m_segment < segments.size() && m_index == segments[m_segment]->size) {
+                ++m_segment;
+                m_index = 0;
+            }
+        }
+    private:
+        owner_type* m_owner_p = nullptr;
+        size_t m_segment = 0;
+        size_t m_index = 0;
+    };
+
+private:
+    my_vector<type_segment*> m_segments;
+    size_t m_size = 0;
+};
+
+}
+
+#endif // MY_POLY_VECTOR_H
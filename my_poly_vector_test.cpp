@@ -0,0 +1,199 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_poly_vector.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace cpp_training;
+
+namespace {
+
+struct event_handler {
+    virtual ~event_handler() {}
+    virtual int handle(int event) const = 0;
+};
+
+struct adder final : event_handler {
+    explicit adder(int k) : k(k) {}
+    int handle(int event) const override { return event + k; }
+    int k;
+};
+
+struct named final : event_handler {
+    explicit named(std::string name) : name(std::move(name)) {}
+    int handle(int event) const override { return event * static_cast<int>(name.size()); }
+    std::string name;
+};
+
+struct tagged {
+    virtual ~tagged() {}
+    int tag = 7;
+};
+
+// The event_handler subobject is not at the start of the object
+struct aligned_handler final : tagged, event_handler {
+    explicit aligned_handler(int k) : k(k) {}
+    int handle(int event) const override { return event - k; }
+    alignas(32) int k;
+};
+
+// Concrete and derived from
+struct doubler : event_handler {
+    int handle(int event) const override { return 2 * event; }
+};
+
+struct tripler final : doubler {
+    int handle(int event) const override { return 3 * event; }
+};
+
+// Copies (also used to move) throw once the budget is spent, the destructor catches double destruction
+struct fragile final : event_handler {
+    static constexpr int Alive = 0x600d;
+    static int budget;
+    static int live;
+    explicit fragile(int k) : k(k) { ++live; }
+    fragile(const fragile& rhs) : event_handler(rhs), k(rhs.k) {
+        if (budget-- <= 0) throw std::runtime_error("out of budget");
+        ++live;
+    }
+    ~fragile() override {
+        EXPECT_EQ(state, Alive);
+        state = 0;
+        --live;
+    }
+    int handle(int event) const override { return event + k; }
+    int state = Alive;
+    int k;
+};
+int fragile::budget = 0;
+int fragile::live = 0;
+
+struct move_only final : event_handler {
+    explicit move_only(int k) : k(new int(k)) {}
+    int handle(int event) const override { return event + *k; }
+    std::unique_ptr<int> k;
+};
+
+}
+
+TEST(MyPolyVectorTest, Segments) {
+    my_poly_vector<event_handler> handlers;
+    EXPECT_TRUE(handlers.is_empty());
+    handlers.emplace<adder>(1);
+    handlers.push_back(named("abc"));
+    handlers.emplace<aligned_handler>(5);
+    handlers.emplace<adder>(2);
+    handlers.push_back(aligned_handler(6));
+    EXPECT_EQ(handlers.size(), 5);
+    EXPECT_EQ(handlers.segment_count(), 3);
+    EXPECT_EQ(handlers.size<adder>(), 2);
+    EXPECT_EQ(handlers.size<move_only>(), 0);
+
+    auto adders = handlers.segment<adder>();
+    ASSERT_EQ(adders.size(), 2);
+    EXPECT_EQ(adders[1].k, 2);
+    auto aligned = handlers.segment<aligned_handler>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&aligned[1].k) % 32, 0);
+
+    // Segment order, then insertion order inside a segment
+    int results[5];
+    int n = 0;
+    for (auto& h : handlers) results[n++] = h.handle(10);
+    EXPECT_EQ(n, 5);
+    EXPECT_EQ(results[0], 11);
+    EXPECT_EQ(results[1], 12);
+    EXPECT_EQ(results[2], 30);
+    EXPECT_EQ(results[3], 5);
+    EXPECT_EQ(results[4], 4);
+
+    int sum = 0;
+    handlers.for_each<adder, aligned_handler>([&sum](auto& h) { sum += h.handle(10); });
+    EXPECT_EQ(sum, 11 + 12 + 30 + 5 + 4);
+    const auto& const_handlers = handlers;
+    sum = 0;
+    const_handlers.for_each([&sum](const event_handler& h) { sum += h.handle(1); });
+    EXPECT_EQ(sum, 2 + 3 + 3 - 4 - 5);
+}
+
+TEST(MyPolyVectorTest, GrowCopyErase) {
+    my_poly_vector<event_handler> handlers;
+    handlers.reserve<named>(2);
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 2) handlers.emplace<adder>(i); else handlers.emplace<named>(std::string(i % 7, 'x'));
+    }
+    EXPECT_EQ(handlers.size<named>(), 500);
+
+    my_poly_vector<event_handler> copy(handlers);
+    auto erased = handlers.erase_if([](const event_handler& h) {
+        auto a = dynamic_cast<const adder*>(&h);
+        return a && a->k % 4 == 1;
+    });
+    EXPECT_EQ(erased, 250);
+    EXPECT_EQ(handlers.size(), 750);
+    EXPECT_EQ(handlers.size<adder>(), 250);
+    int previous = -1;
+    for (auto& a : handlers.segment<adder>()) {
+        EXPECT_EQ(a.k % 4, 3);
+        EXPECT_GT(a.k, previous);
+        previous = a.k;
+    }
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy.segment<named>()[3].name, "xxxxxx");
+
+    handlers.clear();
+    EXPECT_TRUE(handlers.is_empty());
+    EXPECT_TRUE(handlers.begin() == handlers.end());
+    EXPECT_EQ(handlers.segment_count(), 2);
+}
+
+TEST(MyPolyVectorTest, MoveOnlyElements) {
+    my_poly_vector<event_handler> handlers;
+    for (int i = 0; i < 10; ++i) handlers.emplace<move_only>(i);
+    EXPECT_EQ(handlers.segment<move_only>()[9].handle(1), 10);
+    auto moved = std::move(handlers);
+    EXPECT_EQ(moved.size(), 10);
+    EXPECT_TRUE(handlers.is_empty());
+    EXPECT_THROW(my_poly_vector<event_handler> copy(moved), std::logic_error);
+}
+
+TEST(MyPolyVectorTest, PushBackDoesNotSlice) {
+    my_poly_vector<event_handler> handlers;
+    tripler t;
+    handlers.push_back(t);
+    handlers.push_back(doubler());
+    const doubler& as_base = t;
+    EXPECT_THROW(handlers.push_back(as_base), std::invalid_argument);
+    EXPECT_EQ(handlers.size(), 2);
+    EXPECT_EQ(handlers.size<tripler>(), 1);
+    EXPECT_EQ(handlers.size<doubler>(), 1);
+    EXPECT_EQ(handlers.segment<tripler>()[0].handle(1), 3);
+}
+
+TEST(MyPolyVectorTest, OwnElementsAndThrowingCopies) {
+    {
+        my_poly_vector<event_handler> handlers;
+        for (int k = 0; k < 4; ++k) handlers.emplace<fragile>(k);
+        ASSERT_EQ(handlers.size<fragile>(), my_poly_vector<event_handler>::MinSegmentCapacity);
+        // Full segment: the element is read before the segment moves
+        fragile::budget = 100;
+        handlers.push_back(handlers.segment<fragile>()[0]);
+        for (int k = 5; k < 8; ++k) handlers.emplace<fragile>(k);
+        EXPECT_EQ(handlers.segment<fragile>()[4].k, 0);
+
+        // Full again, the third copy into the new storage throws
+        fragile::budget = 2;
+        EXPECT_THROW(handlers.emplace<fragile>(8), std::runtime_error);
+        EXPECT_EQ(handlers.size(), 8);
+        EXPECT_EQ(handlers.segment<fragile>()[7].k, 7);
+
+        // Erasing 1 and 3 moves 2 down, then moving the 0 after 3 throws
+        fragile::budget = 1;
+        EXPECT_THROW(handlers.erase_if([](const event_handler& h) { return static_cast<const fragile&>(h).k % 2; }),
+                     std::runtime_error);
+        EXPECT_EQ(handlers.size(), 2);
+        EXPECT_EQ(handlers.segment<fragile>()[1].k, 2);
+    }
+    EXPECT_EQ(fragile::live, 0);
+}
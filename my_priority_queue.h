@@ -0,0 +1,300 @@
+#ifndef MY_PRIORITY_QUEUE_H
+#define MY_PRIORITY_QUEUE_H
+
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include "my_vector.h"
+
+// Interface : https://en.cppreference.com/w/cpp/container/priority_queue
+
+namespace cpp_training {
+
+namespace detail {
+
+// d-ary heap algorithms over an array, the top is the element which no other compares less than.
+// Elements are moved into a hole instead of swapped, placed(pos) is called for every element put at pos.
+template <size_t Arity>
+struct heap_ops {
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+
+    static size_t parent(size_t pos) { return (pos - 1) / Arity; }
+
+    static size_t first_child(size_t pos) { return pos * Arity + 1; }
+
+    template <typename T, typename Compare, typename Placed>
+    static void sift_up(T* data, size_t pos, Compare comp, Placed&& placed) {
+        T value = std::move(data[pos]);
+        while (pos > 0 && comp(data[parent(pos)], value)) {
+            data[pos] = std::move(data[parent(pos)]);
+            placed(pos);
+            pos = parent(pos);
+        }
+        data[pos] = std::move(value);
+        placed(pos);
+    }
+
+    template <typename T, typename Compare, typename Placed>
+    static void sift_down(T* data, size_t size, size_t pos, Compare comp, Placed&& placed) {
+        T value = std::move(data[pos]);
+        for (;;) {
+            auto child = first_child(pos);
+            if (child >= size) break;
+            // The greatest child, the children of a 4-ary node share a cache line for small T
+            auto last = std::min(child + Arity, size);
+            auto best = child;
+            for (++child; child < last; ++child) {
+                if (comp(data[best], data[child])) best = child;
+            }
+            if (!comp(value, data[best])) break;
+            data[pos] = std::move(data[best]);
+            placed(pos);
+            pos = best;
+        }
+        data[pos] = std::move(value);
+        placed(pos);
+    }
+
+    // Floyd's bottom up construction, O(n)
+    template <typename T, typename Compare, typename Placed>
+    static void make_heap(T* data, size_t size, Compare comp, Placed&& placed) {
+        if (size < 2) return;
+        for (auto pos = parent(size - 1) + 1; pos-- > 0;) {
+            sift_down(data, size, pos, comp, placed);
+        }
+    }
+};
+
+struct no_placement {
+    void operator () (size_t) const {}
+};
+
+}
+
+// Priority queue on a d-ary heap stored in a my_vector. With the default std::less the greatest element is on top.
+// 4 children per node make the heap half as deep as a binary one and the children of a node adjacent,
+// which pays off when sift down dominates, as in pop().
+template <typename T, typename Compare = std::less<T>, size_t Arity = 4>
+class my_priority_queue {
+    using ops = detail::heap_ops<Arity>;
+
+public:
+    using value_type = T;
+    using value_compare = Compare;
+
+public:
+
+    my_priority_queue() {
+    }
+
+    explicit my_priority_queue(const Compare& comp) : m_comp(comp) {
+    }
+
+    // Heapifies values in O(n)
+    explicit my_priority_queue(my_vector<T> values, const Compare& comp = Compare())
+        : m_heap(std::move(values)), m_comp(comp) {
+        ops::make_heap(m_heap.data(), m_heap.size(), m_comp, detail::no_placement());
+    }
+
+    template <typename InputIt>
+    my_priority_queue(InputIt first, InputIt last, const Compare& comp = Compare())
+        : my_priority_queue(my_vector<T>(first, last), comp) {
+    }
+
+    size_t size() const { return m_heap.size(); }
+
+    bool is_empty() const { return m_heap.is_empty(); }
+
+    void reserve(size_t new_cap) { m_heap.reserve(new_cap); }
+
+    const T& top() const { return m_heap.front(); }
+
+    void push(const T& value) {
+        m_heap.push_back(value);
+        ops::sift_up(m_heap.data(), m_heap.size() - 1, m_comp, detail::no_placement());
+    }
+
+    void push(T&& value) {
+        m_heap.push_back(std::move(value));
+        ops::sift_up(m_heap.data(), m_heap.size() - 1, m_comp, detail::no_placement());
+    }
+
+    template< class... Args >
+    void emplace( Args&&... args ) {
+        m_heap.emplace_back(std::forward<Args>(args)...);
+        ops::sift_up(m_heap.data(), m_heap.size() - 1, m_comp, detail::no_placement());
+    }
+
+    // Adds a range. When it is large compared to the heap, rebuilds the heap in O(n + m)
+    // instead of sifting up every element, O(m log(n + m))
+    template <typename InputIt>
+    void push_bulk(InputIt first, InputIt last) {
+        auto old_size = m_heap.size();
+        for (; first != last; ++first) m_heap.push_back(*first);
+        auto added = m_heap.size() - old_size;
+        if (added > old_size / 4) {
+            ops::make_heap(m_heap.data(), m_heap.size(), m_comp, detail::no_placement());
+        } else {
+            for (auto pos = old_size; pos < m_heap.size(); ++pos) {
+                ops::sift_up(m_heap.data(), pos, m_comp, detail::no_placement());
+            }
+        }
+    }
+
+    void push_bulk(const my_vector<T>& values) {
+        push_bulk(values.cbegin(), values.cend());
+    }
+
+    void pop() {
+        if (m_heap.size() > 1) {
+            m_heap.front() = std::move(m_heap.back());
+            m_heap.pop_back();
+            ops::sift_down(m_heap.data(), m_heap.size(), 0, m_comp, detail::no_placement());
+        } else {
+            m_heap.clear();
+        }
+    }
+
+    // Moves the top out and pops it
+    T take_top() {
+        T result = std::move(m_heap.front());
+        pop();
+        return result;
+    }
+
+    void clear() { m_heap.clear(); }
+
+    // The heap array, in heap order
+    const my_vector<T>& heap() const { return m_heap; }
+
+private:
+    my_vector<T> m_heap;
+    Compare m_comp;
+};
+
+// Priority queue whose elements can be reached through handles returned by push(),
+// to change their priority (decrease_key / update) or erase them in O(log n).
+// Handles of popped or erased elements are reused.
+template <typename T, typename Compare = std::less<T>, size_t Arity = 4>
+class my_indexed_priority_queue {
+    using ops = detail::heap_ops<Arity>;
+
+    static constexpr size_t NoPosition = SIZE_MAX;
+
+    struct node {
+        T value;
+        size_t handle;
+    };
+
+    struct node_compare {
+        Compare comp;
+        bool operator () (const node& lhs, const node& rhs) const { return comp(lhs.value, rhs.value); }
+    };
+
+public:
+    using value_type = T;
+    using handle = size_t;
+
+public:
+
+    my_indexed_priority_queue() {
+    }
+
+    explicit my_indexed_priority_queue(const Compare& comp) : m_comp{comp} {
+    }
+
+    size_t size() const { return m_heap.size(); }
+
+    bool is_empty() const { return m_heap.is_empty(); }
+
+    const T& top() const { return m_heap.front().value; }
+
+    handle top_handle() const { return m_heap.front().handle; }
+
+    handle push(const T& value) {
+        handle h;
+        if (m_free.is_empty()) {
+            m_positions.push_back(NoPosition);
+            h = m_positions.size() - 1;
+        } else {
+            h = m_free.back();
+            m_free.pop_back();
+        }
+        m_heap.push_back(node{value, h});
+        sift_up(m_heap.size() - 1);
+        return h;
+    }
+
+    void pop() { erase(top_handle()); }
+
+    bool contains(handle h) const { return h < m_positions.size() && m_positions[h] != NoPosition; }
+
+    const T& value(handle h) const {
+        if (!contains(h)) throw std::out_of_range("handle is not in the queue");
+        return m_heap[m_positions[h]].value;
+    }
+
+    // Sets a value which goes towards the top (with std::greater, a smaller one, hence the name), O(log n)
+    void decrease_key(handle h, const T& value) {
+        auto pos = position(h);
+        if (m_comp.comp(value, m_heap[pos].value)) throw std::invalid_argument("the new value goes away from the top");
+        m_heap[pos].value = value;
+        sift_up(pos);
+    }
+
+    // Sets any value, O(log n)
+    void update(handle h, const T& value) {
+        auto pos = position(h);
+        auto towards_top = m_comp.comp(m_heap[pos].value, value);
+        m_heap[pos].value = value;
+        if (towards_top) sift_up(pos); else sift_down(pos);
+    }
+
+    void erase(handle h) {
+        auto pos = position(h);
+        m_positions[h] = NoPosition;
+        m_free.push_back(h);
+        if (pos + 1 == m_heap.size()) {
+            m_heap.pop_back();
+            return;
+        }
+        auto towards_top = m_comp(m_heap[pos], m_heap.back());
+        m_heap[pos] = std::move(m_heap.back());
+        m_heap.pop_back();
+        if (towards_top) sift_up(pos); else sift_down(pos);
+    }
+
+    void clear() {
+        for (auto& n : m_heap) {
+            m_positions[n.handle] = NoPosition;
+            m_free.push_back(n.handle);
+        }
+        m_heap.clear();
+    }
+
+private:
+    size_t position(handle h) const {
+        if (!contains(h)) throw std::out_of_range("handle is not in the queue");
+        return m_positions[h];
+    }
+
+    void sift_up(size_t pos) {
+        ops::sift_up(m_heap.data(), pos, m_comp, [this](size_t p) { m_positions[m_heap[p].handle] = p; });
+    }
+
+    void sift_down(size_t pos) {
+        ops::sift_down(m_heap.data(), m_heap.size(), pos, m_comp, [this](size_t p) { m_positions[m_heap[p].handle] = p; });
+    }
+
+private:
+    my_vector<node> m_heap;
+    my_vector<size_t> m_positions;      // Heap position of every handle
+    my_vector<handle> m_free;
+    node_compare m_comp;
+};
+
+}
+
+#endif // MY_PRIORITY_QUEUE_H
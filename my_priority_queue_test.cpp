@@ -0,0 +1,131 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_priority_queue.h"
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <random>
+#include <string>
+
+using namespace cpp_training;
+
+namespace {
+
+template <typename Queue>
+my_vector<int> drain(Queue& queue) {
+    my_vector<int> result;
+    while (!queue.is_empty()) {
+        result.push_back(queue.top());
+        queue.pop();
+    }
+    return result;
+}
+
+my_vector<int> random_values(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    my_vector<int> values;
+    for (size_t i = 0; i < count; ++i) values.push_back(static_cast<int>(gen() % 1000));
+    return values;
+}
+
+}
+
+TEST(MyPriorityQueueTest, HeapifyAndPop) {
+    auto values = random_values(1000, 1);
+    my_priority_queue<int> queue(values);
+    EXPECT_EQ(queue.size(), 1000);
+    auto sorted = values;
+    std::sort(sorted.data(), sorted.data() + sorted.size(), std::greater<int>());
+    EXPECT_EQ(drain(queue), sorted);
+
+    my_priority_queue<int, std::greater<int>, 2> binary(values.begin(), values.end());
+    std::sort(sorted.data(), sorted.data() + sorted.size());
+    EXPECT_EQ(drain(binary), sorted);
+}
+
+TEST(MyPriorityQueueTest, PushAndBulk) {
+    my_priority_queue<std::string> queue;
+    queue.push("b");
+    queue.emplace("d");
+    queue.push(std::string("a"));
+    EXPECT_EQ(queue.top(), "d");
+    EXPECT_EQ(queue.take_top(), "d");
+    EXPECT_EQ(queue.top(), "b");
+
+    my_priority_queue<int, std::less<int>, 3> ints;
+    std::priority_queue<int> model;
+    for (unsigned round = 0; round < 20; ++round) {
+        // Alternates small bulks (sifted up) and large ones (heap rebuilt)
+        auto bulk = random_values(round % 2 ? 3 : 200, round);
+        ints.push_bulk(bulk);
+        for (auto value : bulk) model.push(value);
+        for (int i = 0; i < 50 && !model.empty(); ++i) {
+            ASSERT_EQ(ints.top(), model.top());
+            ints.pop();
+            model.pop();
+        }
+    }
+    EXPECT_EQ(ints.size(), model.size());
+}
+
+TEST(MyPriorityQueueTest, IndexedDecreaseKey) {
+    // Min queue, as in Dijkstra's algorithm
+    my_indexed_priority_queue<int, std::greater<int>> queue;
+    auto a = queue.push(50);
+    auto b = queue.push(20);
+    auto c = queue.push(30);
+    EXPECT_EQ(queue.top(), 20);
+    EXPECT_EQ(queue.top_handle(), b);
+
+    queue.decrease_key(c, 10);
+    EXPECT_EQ(queue.top_handle(), c);
+    EXPECT_THROW(queue.decrease_key(a, 60), std::invalid_argument);
+    queue.update(c, 100);
+    EXPECT_EQ(queue.top_handle(), b);
+    EXPECT_EQ(queue.value(c), 100);
+
+    queue.erase(b);
+    EXPECT_FALSE(queue.contains(b));
+    EXPECT_THROW(queue.value(b), std::out_of_range);
+    EXPECT_EQ(queue.top(), 50);
+    queue.pop();
+    EXPECT_EQ(queue.top_handle(), c);
+    EXPECT_EQ(queue.size(), 1);
+}
+
+TEST(MyPriorityQueueTest, IndexedMatchesModel) {
+    my_indexed_priority_queue<int> queue;
+    std::map<size_t, int> model;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 5000; ++i) {
+        auto op = gen() % 4;
+        if (model.empty() || op == 0) {
+            int value = gen() % 1000;
+            model[queue.push(value)] = value;
+        } else {
+            auto it = model.begin();
+            std::advance(it, gen() % model.size());
+            if (op == 1) {
+                int value = gen() % 1000;
+                queue.update(it->first, value);
+                it->second = value;
+            } else if (op == 2) {
+                queue.erase(it->first);
+                model.erase(it);
+            } else {
+                auto top = std::max_element(model.begin(), model.end(),
+                    [](const std::pair<const size_t, int>& l, const std::pair<const size_t, int>& r) { return l.second < r.second; });
+                ASSERT_EQ(queue.top(), top->second);
+                model.erase(queue.top_handle());
+                queue.pop();
+            }
+        }
+        ASSERT_EQ(queue.size(), model.size());
+    }
+    for (auto& item : model) {
+        ASSERT_EQ(queue.value(item.first), item.second);
+    }
+    queue.clear();
+    EXPECT_TRUE(queue.is_empty());
+}
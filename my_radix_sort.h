@@ -0,0 +1,300 @@
+#ifndef MY_RADIX_SORT_H
+#define MY_RADIX_SORT_H
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <exception>
+#include <algorithm>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_parallel.h"
+
+namespace cpp_training {
+
+namespace detail {
+
+// Order preserving map of a key onto an unsigned integer of the same size, and back.
+// Signed integers get their sign bit flipped; floating point numbers get it flipped when positive
+// and all bits flipped when negative, so -inf < -1 < -0 < +0 < 1 < +inf,
+// negative NaNs go before -inf and positive ones after +inf
+template <typename K, typename = void>
+struct radix_traits;
+
+template <typename K>
+struct radix_traits<K, std::enable_if_t<std::is_integral<K>::value && !std::is_same<K, bool>::value>> {
+    using type = std::make_unsigned_t<K>;
+    static constexpr type SignBit = std::is_signed<K>::value ? type(type(1) << (sizeof(K) * 8 - 1)) : type(0);
+
+    static type to_radix(K key) { return static_cast<type>(key) ^ SignBit; }
+
+    static K from_radix(type bits) { return static_cast<K>(bits ^ SignBit); }
+};
+
+template <typename K>
+struct radix_traits<K, std::enable_if_t<std::is_floating_point<K>::value>> {
+    static_assert(sizeof(K) == 4 || sizeof(K) == 8, "float and double keys are supported");
+    using type = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+    static constexpr type SignBit = type(1) << (sizeof(K) * 8 - 1);
+
+    static type to_radix(K key) {
+        type bits;
+        std::memcpy(&bits, &key, sizeof(key));
+        return bits ^ ((bits & SignBit) ? ~type(0) : SignBit);
+    }
+
+    static K from_radix(type bits) {
+        bits ^= (bits & SignBit) ? SignBit : ~type(0);
+        K key;
+        std::memcpy(&key, &bits, sizeof(key));
+        return key;
+    }
+};
+
+// Inputs up to this size are sorted by the small sorts below
+constexpr size_t RadixSmallSort = 64;
+
+// Above this size the keys of 32 bits and more are sorted by 11 bit digits
+constexpr size_t RadixWideDigits = 1 << 16;
+
+// Digits of Bits bits of the unsigned key U
+template <typename U, unsigned Bits>
+struct radix_digits {
+    static constexpr size_t Buckets = size_t(1) << Bits;
+    static constexpr unsigned Passes = (sizeof(U) * 8 + Bits - 1) / Bits;
+
+    static size_t digit(U bits, unsigned pass) { return (bits >> (pass * Bits)) & (Buckets - 1); }
+};
+
+// Bitonic sorting network over n (a power of 2) values.
+// Every comparator of a step works on the same stride j, with branchless min / max in a contiguous inner loop,
+// so for j at least the vector width the compiler turns a whole step into vector min / max instructions
+template <typename U>
+void bitonic_sort(U* x, size_t n) {
+    for (size_t k = 2; k <= n; k *= 2) {
+        for (size_t j = k / 2; j > 0; j /= 2) {
+            for (size_t i = 0; i < n; i += 2 * j) {
+                U* lo = x + i;
+                U* hi = x + i + j;
+                if ((i & k) == 0) {
+                    for (size_t t = 0; t < j; ++t) {
+                        U a = lo[t], b = hi[t];
+                        lo[t] = std::min(a, b);
+                        hi[t] = std::max(a, b);
+                    }
+                } else {
+                    for (size_t t = 0; t < j; ++t) {
+                        U a = lo[t], b = hi[t];
+                        lo[t] = std::max(a, b);
+                        hi[t] = std::min(a, b);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Sorts up to RadixSmallSort numbers through the network, padded to a power of 2 with the largest key
+template <typename T>
+void small_sort(T* x, size_t n) {
+    using traits = radix_traits<T>;
+    using U = typename traits::type;
+    U keys[RadixSmallSort];
+    size_t padded = 1;
+    while (padded < n) padded *= 2;
+    for (size_t i = 0; i < n; ++i) keys[i] = traits::to_radix(x[i]);
+    std::fill(keys + n, keys + padded, U(~U(0)));
+    bitonic_sort(keys, padded);
+    for (size_t i = 0; i < n; ++i) x[i] = traits::from_radix(keys[i]);
+}
+
+// Stable insertion sort by key, for elements which aren't numbers themselves
+template <typename T, typename Key>
+void small_sort(T* x, size_t n, Key& key) {
+    using traits = radix_traits<std::decay_t<decltype(key(*x))>>;
+    for (size_t i = 1; i < n; ++i) {
+        auto bits = traits::to_radix(key(x[i]));
+        if (traits::to_radix(key(x[i - 1])) <= bits) continue;
+        T value = std::move(x[i]);
+        size_t j = i;
+        for (; j > 0 && traits::to_radix(key(x[j - 1])) > bits; --j) x[j] = std::move(x[j - 1]);
+        x[j] = std::move(value);
+    }
+}
+
+// Stable distribution of src into dst by the digit of pass, offsets[d] is where the next element with digit d goes
+// Small trivially copyable elements are gathered per bucket in a cache line sized buffer first and written out a line
+// at a time, so the scattered stores don't miss the cache and the TLB once per element
+template <typename T, typename Key, typename Traits, typename Digits>
+void radix_scatter(T* src, T* dst, size_t first, size_t last, size_t* offsets, unsigned pass, Key& key) {
+    if constexpr (std::is_trivially_copyable<T>::value && sizeof(T) <= 16) {
+        constexpr size_t Line = 64 / sizeof(T);
+        alignas(64) T buffers[Digits::Buckets][Line];
+        unsigned char fill[Digits::Buckets] = {};
+        for (size_t i = first; i < last; ++i) {
+            auto d = Digits::digit(Traits::to_radix(key(src[i])), pass);
+            std::memcpy(&buffers[d][fill[d]++], src + i, sizeof(T));
+            if (fill[d] == Line) {
+                std::memcpy(dst + offsets[d], buffers[d], sizeof(buffers[d]));
+                offsets[d] += Line;
+                fill[d] = 0;
+            }
+        }
+        for (size_t d = 0; d < Digits::Buckets; ++d) {
+            std::memcpy(dst + offsets[d], buffers[d], fill[d] * sizeof(T));
+            offsets[d] += fill[d];
+        }
+    } else {
+        for (size_t i = first; i < last; ++i) {
+            dst[offsets[Digits::digit(Traits::to_radix(key(src[i])), pass)]++] = std::move(src[i]);
+        }
+    }
+}
+
+// Runs fn(chunk, first, last) on the chunks of [0, n) in parallel, rethrows the first exception
+template <typename Fn>
+void radix_parallel(const parallel_policy& policy, size_t n, size_t chunks, Fn&& fn) {
+    my_vector<std::exception_ptr> errors(chunks);
+    parallel_chunks(policy, n, errors.data(), fn);
+    for (size_t i = 0; i < chunks; ++i) {
+        if (errors[i]) std::rethrow_exception(errors[i]);
+    }
+}
+
+template <unsigned Bits, typename T, typename Key>
+void radix_sort_by(my_vector<T>& v, Key& key, const parallel_policy* policy) {
+    using K = std::decay_t<decltype(key(v[0]))>;
+    using traits = radix_traits<K>;
+    using U = typename traits::type;
+    using digits = radix_digits<U, Bits>;
+    constexpr size_t Buckets = digits::Buckets;
+    constexpr unsigned Passes = digits::Passes;
+
+    const size_t n = v.size();
+    const size_t chunks = policy ? parallel_chunk_count(*policy, n) : 1;
+
+    // The histograms of all passes in one read of the keys, per chunk: counts[(chunk * Passes + pass) * Buckets + digit]
+    my_vector<size_t> counts(chunks * Passes * Buckets, 0);
+    auto histogram = [&](const T* src, size_t chunk, size_t first, size_t last, unsigned pass_first, unsigned pass_last) {
+        size_t* c = counts.data() + chunk * Passes * Buckets;
+        for (size_t i = first; i < last; ++i) {
+            auto bits = traits::to_radix(key(src[i]));
+            for (unsigned pass = pass_first; pass < pass_last; ++pass) ++c[pass * Buckets + digits::digit(bits, pass)];
+        }
+    };
+    if (chunks == 1) {
+        histogram(v.data(), 0, 0, n, 0, Passes);
+    } else {
+        radix_parallel(*policy, n, chunks, [&](size_t chunk, size_t first, size_t last) {
+            histogram(v.data(), chunk, first, last, 0, Passes);
+        });
+    }
+
+    my_vector<T> scratch = policy ? my_vector<T>(*policy, n) : my_vector<T>(n);
+    T* src = v.data();
+    T* dst = scratch.data();
+    bool counted = true;        // Whether the per chunk counts of the next pass match the order of src
+    my_vector<size_t> offsets(chunks * Buckets, 0);
+    for (unsigned pass = 0; pass < Passes; ++pass) {
+        // A digit shared by all keys doesn't change the order, which saves whole passes on narrow values
+        auto first_digit = digits::digit(traits::to_radix(key(src[0])), pass);
+        size_t total = 0;
+        for (size_t chunk = 0; chunk < chunks; ++chunk) total += counts[(chunk * Passes + pass) * Buckets + first_digit];
+        if (total == n) continue;
+
+        if (!counted) {
+            // The totals of the later passes don't depend on the order, their counts are kept for the check above
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                auto c = counts.data() + (chunk * Passes + pass) * Buckets;
+                std::fill(c, c + Buckets, size_t(0));
+            }
+            radix_parallel(*policy, n, chunks, [&](size_t chunk, size_t first, size_t last) {
+                histogram(src, chunk, first, last, pass, pass + 1);
+            });
+        }
+        // Bucket after bucket, chunk after chunk within a bucket, so the sort stays stable
+        size_t offset = 0;
+        for (size_t d = 0; d < Buckets; ++d) {
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                offsets[chunk * Buckets + d] = offset;
+                offset += counts[(chunk * Passes + pass) * Buckets + d];
+            }
+        }
+        if (chunks == 1) {
+            radix_scatter<T, Key, traits, digits>(src, dst, 0, n, offsets.data(), pass, key);
+        } else {
+            radix_parallel(*policy, n, chunks, [&](size_t chunk, size_t first, size_t last) {
+                radix_scatter<T, Key, traits, digits>(src, dst, first, last, offsets.data() + chunk * Buckets, pass, key);
+            });
+            counted = false;
+        }
+        std::swap(src, dst);
+    }
+    if (src != v.data()) v.swap(scratch);
+}
+
+// Every pass reads and writes all elements, so large inputs are bound by memory bandwidth and fewer passes win:
+// 11 bit digits sort 32 bit keys in 3 passes and 64 bit ones in 6 rather than 4 and 8, and the 2048 bucket histogram
+// of a pass still fits the L1 cache. Smaller inputs and narrow keys go 8 bits at a time,
+// where walking 2048 buckets per pass would cost more than the passes saved
+template <typename T, typename Key>
+void radix_sort(my_vector<T>& v, Key& key, const parallel_policy* policy) {
+    using U = typename radix_traits<std::decay_t<decltype(key(v[0]))>>::type;
+    if (sizeof(U) >= 4 && v.size() > RadixWideDigits) {
+        radix_sort_by<11>(v, key, policy);
+    } else {
+        radix_sort_by<8>(v, key, policy);
+    }
+}
+
+}
+
+// Stable LSD radix sort of integers and floating point numbers in ascending order, O(n) with a buffer of n elements.
+// The histograms of all passes are taken in one read up front and passes over a digit shared by all keys are skipped,
+// so small values in wide types cost fewer passes. Up to 64 elements are sorted by a bitonic network instead.
+// Floating point numbers are sorted by value with -0 before +0, NaNs by their sign bit at either end
+template <typename T>
+void radix_sort(my_vector<T>& v) {
+    if (v.size() <= detail::RadixSmallSort) {
+        detail::small_sort(v.data(), v.size());
+        return;
+    }
+    auto key = [](const T& value) { return value; };
+    detail::radix_sort(v, key, nullptr);
+}
+
+// Sorts v by key(element), which returns an integer or a floating point number, keeping the order of equal keys.
+// For key / value pairs and records, v needs default constructible and move assignable elements.
+// key is called several times per element and should be cheap; if it throws, v holds unspecified values
+template <typename T, typename Key>
+void radix_sort(my_vector<T>& v, Key key) {
+    if (v.size() <= detail::RadixSmallSort) {
+        detail::small_sort(v.data(), v.size(), key);
+        return;
+    }
+    detail::radix_sort(v, key, nullptr);
+}
+
+// Parallel versions: the histograms and the scatter of every pass run on contiguous chunks in parallel
+template <typename T>
+void radix_sort(const parallel_policy& policy, my_vector<T>& v) {
+    if (v.size() <= detail::RadixSmallSort) {
+        detail::small_sort(v.data(), v.size());
+        return;
+    }
+    auto key = [](const T& value) { return value; };
+    detail::radix_sort(v, key, &policy);
+}
+
+template <typename T, typename Key>
+void radix_sort(const parallel_policy& policy, my_vector<T>& v, Key key) {
+    if (v.size() <= detail::RadixSmallSort) {
+        detail::small_sort(v.data(), v.size(), key);
+        return;
+    }
+    detail::radix_sort(v, key, &policy);
+}
+
+}
+
+#endif // MY_RADIX_SORT_H
@@ -0,0 +1,48 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// Time to sort random uint64_t keys with std::sort, radix_sort and the parallel radix_sort,
+// for counts from cache resident to the size of the nightly job. Usage: MyVector_RADIX_BENCH [max keys]
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include "my_radix_sort.h"
+
+using namespace cpp_training;
+
+namespace {
+
+template <typename Sort>
+double ms_to_sort(const my_vector<uint64_t>& keys, Sort sort) {
+    auto copy = keys;
+    auto start = std::chrono::steady_clock::now();
+    sort(copy);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!std::is_sorted(copy.begin(), copy.end())) std::cout << "not sorted" << std::endl;
+    return elapsed;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_keys = argc > 1 ? std::stoull(argv[1]) : 100000000;
+    std::mt19937_64 gen(1);
+
+    std::cout << std::setw(12) << "keys" << std::setw(16) << "std::sort ms"
+              << std::setw(16) << "radix ms" << std::setw(16) << "par radix ms" << std::endl;
+    for (size_t count = 1000; count <= max_keys; count *= 10) {
+        my_vector<uint64_t> keys;
+        keys.reserve(count);
+        for (size_t i = 0; i < count; ++i) keys.push_back(gen());
+
+        auto std_ms = ms_to_sort(keys, [](my_vector<uint64_t>& v) { std::sort(v.data(), v.data() + v.size()); });
+        auto radix_ms = ms_to_sort(keys, [](my_vector<uint64_t>& v) { radix_sort(v); });
+        auto par_ms = ms_to_sort(keys, [](my_vector<uint64_t>& v) { radix_sort(par, v); });
+        std::cout << std::setw(12) << count << std::fixed << std::setprecision(1)
+                  << std::setw(16) << std_ms << std::setw(16) << radix_ms << std::setw(16) << par_ms << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_radix_sort.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <utility>
+
+using namespace cpp_training;
+
+namespace {
+
+// Sizes around the small sort limit, and ones spanning several parallel chunks
+const size_t Sizes[] = {0, 1, 2, 3, 7, 31, 63, 64, 65, 100, 1000, 200000};
+
+template <typename T>
+my_vector<T> random_values(size_t n, unsigned seed) {
+    std::mt19937_64 gen(seed);
+    my_vector<T> result;
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if constexpr (std::is_floating_point<T>::value) {
+            result.push_back(std::uniform_real_distribution<T>(-1e6, 1e6)(gen));
+        } else {
+            result.push_back(static_cast<T>(gen()));
+        }
+    }
+    return result;
+}
+
+template <typename T>
+void expect_sorted_like_std(my_vector<T> v) {
+    auto expected = v;
+    std::sort(expected.data(), expected.data() + expected.size());
+    auto parallel = v;
+    radix_sort(v);
+    ASSERT_EQ(v, expected) << v.size();
+    radix_sort(parallel_policy{4}, parallel);
+    ASSERT_EQ(parallel, expected) << parallel.size();
+}
+
+template <typename T>
+void check_type() {
+    for (auto n : Sizes) expect_sorted_like_std(random_values<T>(n, static_cast<unsigned>(n)));
+}
+
+}
+
+TEST(MyRadixSortTest, Integers) {
+    check_type<uint8_t>();
+    check_type<int16_t>();
+    check_type<uint32_t>();
+    check_type<int32_t>();
+    check_type<uint64_t>();
+    check_type<int64_t>();
+}
+
+TEST(MyRadixSortTest, FloatingPoint) {
+    check_type<float>();
+    check_type<double>();
+
+    const auto inf = std::numeric_limits<double>::infinity();
+    my_vector<double> special {3.5, -0.0, inf, -1e-300, 0.0, -inf, std::numeric_limits<double>::denorm_min(), -2.5};
+    for (size_t copies = 0; copies < 20; ++copies) special.push_back(special[copies % 8] * 2);
+    auto v = special;
+    radix_sort(v);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    EXPECT_EQ(v[0], -inf);
+    EXPECT_EQ(v.back(), inf);
+    // -0 goes before +0
+    auto zeros = std::equal_range(v.begin(), v.end(), 0.0);
+    EXPECT_TRUE(std::signbit(*zeros.first));
+    EXPECT_FALSE(std::signbit(*(zeros.second - 1)));
+    EXPECT_TRUE(std::is_partitioned(zeros.first, zeros.second, [](double x) { return std::signbit(x); }));
+}
+
+TEST(MyRadixSortTest, NarrowValuesInWideTypes) {
+    // Only the lowest digit differs, and values sharing all digits but one
+    for (auto n : Sizes) {
+        auto v = random_values<uint64_t>(n, 7);
+        for (auto& x : v) x %= 200;
+        expect_sorted_like_std(v);
+        for (auto& x : v) x = (x << 40) | 0xFF;
+        expect_sorted_like_std(v);
+    }
+    my_vector<uint32_t> same(1000, 42u);
+    radix_sort(same);
+    EXPECT_EQ(same, my_vector<uint32_t>(1000, 42u));
+}
+
+TEST(MyRadixSortTest, KeyValuePairs) {
+    using entry = std::pair<int32_t, size_t>;
+    for (auto n : Sizes) {
+        // Few distinct keys, the second member records the original position
+        my_vector<entry> v;
+        std::mt19937 gen(static_cast<unsigned>(n));
+        for (size_t i = 0; i < n; ++i) v.push_back(entry(static_cast<int32_t>(gen() % 50) - 25, i));
+        auto expected = v;
+        std::stable_sort(expected.data(), expected.data() + expected.size(),
+                         [](const entry& a, const entry& b) { return a.first < b.first; });
+        auto parallel = v;
+        radix_sort(v, [](const entry& e) { return e.first; });
+        ASSERT_EQ(v, expected) << n;
+        radix_sort(parallel_policy{4}, parallel, [](const entry& e) { return e.first; });
+        ASSERT_EQ(parallel, expected) << n;
+    }
+
+    // Sorting by a floating point member, descending through a negated key
+    my_vector<std::pair<float, int>> scored {{0.5f, 1}, {-2.0f, 2}, {3.25f, 3}, {0.5f, 4}};
+    radix_sort(scored, [](const std::pair<float, int>& e) { return -e.first; });
+    my_vector<std::pair<float, int>> expected {{3.25f, 3}, {0.5f, 1}, {0.5f, 4}, {-2.0f, 2}};
+    EXPECT_EQ(scored, expected);
+}
+
+TEST(MyRadixSortTest, BitonicNetwork) {
+    std::mt19937 gen(3);
+    for (size_t n = 1; n <= 64; n *= 2) {
+        for (int round = 0; round < 50; ++round) {
+            uint32_t keys[64];
+            for (size_t i = 0; i < n; ++i) keys[i] = gen() % 10;
+            detail::bitonic_sort(keys, n);
+            ASSERT_TRUE(std::is_sorted(keys, keys + n)) << n;
+        }
+    }
+}
@@ -0,0 +1,215 @@
+#ifndef MY_RCU_VECTOR_H
+#define MY_RCU_VECTOR_H
+
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include "my_vector.h"
+
+namespace cpp_training {
+
+// Read-copy-update vector for read mostly data.
+// Readers pin the current version and read it without any locking: pinning is a couple of atomic
+// operations and never waits for the writer. The writer builds a new my_vector and publishes it atomically,
+// the replaced versions are freed once no reader can still be looking at them (epoch based reclamation).
+//
+// Usage:
+//   auto rd = table.make_reader();     // once per reading thread, claims a reader slot
+//   auto snap = rd.pin();              // cheap, wait free
+//   use(snap[0], snap.size());         // the version stays alive while snap exists
+//
+// Writers are serialized by a mutex which readers never touch.
+template <typename T>
+class my_rcu_vector {
+public:
+    static constexpr size_t MaxReaders = 128;
+
+private:
+    static constexpr uint64_t Inactive = UINT64_MAX;
+
+    struct alignas(64) reader_slot {
+        std::atomic<uint64_t> epoch {Inactive};
+        std::atomic<bool> taken {false};
+    };
+
+    struct retired_version {
+        my_vector<T>* data_p;
+        uint64_t epoch;
+    };
+
+public:
+    class reader;
+
+    // Pinned version of the vector
+    class snapshot {
+        friend class reader;
+    public:
+        using const_iterator = typename my_vector<T>::const_iterator;
+
+        snapshot(const snapshot&) = delete;
+        snapshot& operator = (const snapshot&) = delete;
+
+        snapshot(snapshot&& rhs) noexcept : m_reader_p(rhs.m_reader_p), m_data_p(rhs.m_data_p) {
+            rhs.m_reader_p = nullptr;
+        }
+
+        ~snapshot() {
+            if (m_reader_p) m_reader_p->unpin();
+        }
+
+        const my_vector<T>& operator * () const { return *m_data_p; }
+
+        const my_vector<T>* operator -> () const { return m_data_p; }
+
+        const T& operator [] (size_t i) const { return (*m_data_p)[i]; }
+
+        size_t size() const { return m_data_p->size(); }
+
+        const_iterator begin() const { return m_data_p->cbegin(); }
+
+        const_iterator end() const { return m_data_p->cend(); }
+
+    private:
+        snapshot(reader* reader_p, const my_vector<T>* data_p) : m_reader_p(reader_p), m_data_p(data_p) {}
+
+    private:
+        reader* m_reader_p;
+        const my_vector<T>* m_data_p;
+    };
+
+    // Registration of a reading thread, owns one reader slot.
+    // Must be used by one thread at a time, nested pins are allowed.
+    class reader {
+        friend class my_rcu_vector;
+    public:
+        reader(const reader&) = delete;
+        reader& operator = (const reader&) = delete;
+
+        reader(reader&& rhs) noexcept : m_owner_p(rhs.m_owner_p), m_slot_p(rhs.m_slot_p), m_pins(rhs.m_pins) {
+            rhs.m_slot_p = nullptr;
+        }
+
+        ~reader() {
+            if (m_slot_p) m_slot_p->taken.store(false, std::memory_order_release);
+        }
+
+        // Wait free
+        snapshot pin() {
+            if (m_pins++ == 0) {
+                // Announce the epoch before reading the pointer, the writer checks them in the reverse order
+                m_slot_p->epoch.store(m_owner_p->m_epoch.load());
+            }
+            return snapshot(this, m_owner_p->m_current.load());
+        }
+
+    private:
+        reader(my_rcu_vector* owner_p, reader_slot* slot_p) : m_owner_p(owner_p), m_slot_p(slot_p) {}
+
+        void unpin() {
+            if (--m_pins == 0) {
+                m_slot_p->epoch.store(Inactive, std::memory_order_release);
+            }
+        }
+
+    private:
+        my_rcu_vector* m_owner_p;
+        reader_slot* m_slot_p;
+        size_t m_pins = 0;
+    };
+
+public:
+
+    my_rcu_vector() : m_current(new my_vector<T>()) {
+    }
+
+    explicit my_rcu_vector(my_vector<T> initial) : m_current(new my_vector<T>(std::move(initial))) {
+    }
+
+    my_rcu_vector(const my_rcu_vector&) = delete;
+    my_rcu_vector& operator = (const my_rcu_vector&) = delete;
+
+    // All readers must be gone
+    ~my_rcu_vector() {
+        delete m_current.load();
+        for (auto& r : m_retired) {
+            delete r.data_p;
+        }
+    }
+
+    // Claims a reader slot, throws std::length_error if all MaxReaders slots are taken
+    reader make_reader() {
+        for (auto& slot : m_slots) {
+            bool expected = false;
+            if (!slot.taken.load(std::memory_order_relaxed)
+                    && slot.taken.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return reader(this, &slot);
+            }
+        }
+        throw std::length_error("too many readers");
+    }
+
+    // Replaces the content, readers see either the old or the new version as a whole
+    void publish(my_vector<T> data) {
+        auto fresh_p = new my_vector<T>(std::move(data));
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        auto old_p = m_current.exchange(fresh_p);
+        m_retired.push_back(retired_version{old_p, m_epoch.fetch_add(1)});
+        reclaim_locked();
+    }
+
+    // Publishes a modified copy of the current version, fn receives my_vector<T>&
+    template <typename Fn>
+    void update(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        // Versions are only freed by writers, so the current one can be read here without pinning
+        auto fresh_p = new my_vector<T>(*m_current.load());
+        try {
+            fn(*fresh_p);
+        } catch (...) {
+            delete fresh_p;
+            throw;
+        }
+        auto old_p = m_current.exchange(fresh_p);
+        m_retired.push_back(retired_version{old_p, m_epoch.fetch_add(1)});
+        reclaim_locked();
+    }
+
+    // Frees replaced versions which are not pinned anymore, returns the number of versions still waiting
+    size_t reclaim() {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        reclaim_locked();
+        return m_retired.size();
+    }
+
+private:
+    void reclaim_locked() {
+        auto oldest_pinned = Inactive;
+        for (auto& slot : m_slots) {
+            oldest_pinned = std::min(oldest_pinned, slot.epoch.load());
+        }
+        // A version retired at epoch e may be seen by the readers which announced epoch e or older
+        size_t kept = 0;
+        for (size_t i = 0; i < m_retired.size(); ++i) {
+            if (m_retired[i].epoch < oldest_pinned) {
+                delete m_retired[i].data_p;
+            } else {
+                m_retired[kept++] = m_retired[i];
+            }
+        }
+        m_retired.resize(kept);
+    }
+
+private:
+    alignas(64) std::atomic<my_vector<T>*> m_current;
+    alignas(64) std::atomic<uint64_t> m_epoch {0};
+    reader_slot m_slots[MaxReaders];
+    std::mutex m_writer_mutex;
+    my_vector<retired_version> m_retired;
+};
+
+}
+
+#endif // MY_RCU_VECTOR_H
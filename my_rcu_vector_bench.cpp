@@ -0,0 +1,97 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// Read throughput of my_rcu_vector vs my_vector behind std::shared_mutex at 1..64 reader threads,
+// while one writer republishes the table every millisecond. The writes column shows writer starvation.
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "my_rcu_vector.h"
+
+using namespace cpp_training;
+
+namespace {
+
+constexpr size_t TableSize = 4096;
+constexpr auto RunTime = std::chrono::milliseconds(300);
+
+struct result {
+    double reads_per_sec;
+    int writes;
+};
+
+template <typename ReadFn, typename WriteFn>
+result run(int readers, ReadFn read, WriteFn write) {
+    std::atomic<bool> stop {false};
+    std::atomic<uint64_t> total {0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t] {
+            uint64_t ops = 0, sink = 0;
+            size_t idx = t;
+            read(stop, ops, sink, idx);
+            total += ops + (sink == 42 ? 1 : 0);
+        });
+    }
+    int version = 0;
+    std::thread writer([&] {
+        while (!stop.load()) {
+            write(++version);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(RunTime);
+    stop = true;
+    for (auto& th : threads) th.join();
+    auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    writer.join();
+    return result{total / secs, version};
+}
+
+}
+
+int main() {
+    std::cout << std::setw(8) << "threads" << std::setw(20) << "shared_mutex op/s" << std::setw(10) << "writes"
+              << std::setw(20) << "rcu op/s" << std::setw(10) << "writes" << std::endl;
+    for (int readers : {1, 2, 4, 8, 16, 32, 64}) {
+        my_vector<uint64_t> locked_table(TableSize, 0);
+        std::shared_mutex mutex;
+        auto locked = run(readers,
+            [&](std::atomic<bool>& stop, uint64_t& ops, uint64_t& sink, size_t idx) {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    std::shared_lock<std::shared_mutex> lock(mutex);
+                    sink += locked_table[idx++ % TableSize];
+                    ++ops;
+                }
+            },
+            [&](int version) {
+                my_vector<uint64_t> fresh(TableSize, version);
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                locked_table.swap(fresh);
+            });
+
+        my_rcu_vector<uint64_t> rcu_table(my_vector<uint64_t>(TableSize, 0));
+        auto rcu = run(readers,
+            [&](std::atomic<bool>& stop, uint64_t& ops, uint64_t& sink, size_t idx) {
+                auto rd = rcu_table.make_reader();
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto snap = rd.pin();
+                    sink += snap[idx++ % TableSize];
+                    ++ops;
+                }
+            },
+            [&](int version) {
+                rcu_table.publish(my_vector<uint64_t>(TableSize, version));
+            });
+
+        std::cout << std::setw(8) << readers << std::fixed << std::setprecision(0)
+                  << std::setw(20) << locked.reads_per_sec << std::setw(10) << locked.writes
+                  << std::setw(20) << rcu.reads_per_sec << std::setw(10) << rcu.writes << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_rcu_vector.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace cpp_training;
+
+TEST(MyRcuVectorTest, PinAndPublish) {
+    my_rcu_vector<int> table(my_vector<int>{1, 2, 3});
+    auto rd = table.make_reader();
+    {
+        auto snap = rd.pin();
+        EXPECT_EQ(snap.size(), 3);
+        EXPECT_EQ(snap[1], 2);
+
+        table.publish(my_vector<int>{4, 5});
+        // The pinned version is still intact
+        EXPECT_EQ(*snap, (my_vector<int>{1, 2, 3}));
+        EXPECT_EQ(table.reclaim(), 1);
+
+        // Nested pin sees the new version
+        auto snap2 = rd.pin();
+        EXPECT_EQ(*snap2, (my_vector<int>{4, 5}));
+    }
+    EXPECT_EQ(table.reclaim(), 0);
+
+    table.update([](my_vector<int>& v) { v.push_back(6); });
+    auto snap = rd.pin();
+    EXPECT_EQ(*snap, (my_vector<int>{4, 5, 6}));
+    int sum = 0;
+    for (auto v : snap) sum += v;
+    EXPECT_EQ(sum, 15);
+}
+
+TEST(MyRcuVectorTest, ReaderSlots) {
+    my_rcu_vector<int> table;
+    std::vector<my_rcu_vector<int>::reader> readers;
+    for (size_t i = 0; i < my_rcu_vector<int>::MaxReaders; ++i) {
+        readers.push_back(table.make_reader());
+    }
+    EXPECT_THROW(table.make_reader(), std::length_error);
+    readers.pop_back();
+    auto rd = table.make_reader();
+    EXPECT_EQ(rd.pin().size(), 0);
+}
+
+TEST(MyRcuVectorTest, ConcurrentReaders) {
+    // Every published version holds the same value in all elements
+    my_rcu_vector<int> table(my_vector<int>(256, 0));
+    std::atomic<bool> stop {false};
+    std::atomic<int> torn {0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            auto rd = table.make_reader();
+            while (!stop.load()) {
+                auto snap = rd.pin();
+                for (auto v : snap) {
+                    if (v != snap[0]) ++torn;
+                }
+            }
+        });
+    }
+    for (int version = 1; version <= 500; ++version) {
+        table.publish(my_vector<int>(256, version));
+    }
+    stop = true;
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(table.reclaim(), 0);
+}
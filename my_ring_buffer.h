@@ -0,0 +1,306 @@
+#ifndef MY_RING_BUFFER_H
+#define MY_RING_BUFFER_H
+
+#include <new>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_span.h"
+
+namespace cpp_training {
+
+// What push_back/push_front do when the ring buffer is full
+enum class ring_overflow {
+    grow,               // Reallocate with twice the capacity
+    overwrite_oldest    // Drop the element at the opposite end
+};
+
+// Circular buffer with O(1) push and pop at both ends.
+// The storage is a my_vector of raw slots with power of two capacity, so wrapping an index is a single mask.
+// The content occupies at most two contiguous parts of the storage, see as_spans().
+template <typename T>
+class my_ring_buffer {
+    template <bool Const>
+    class ring_iterator;
+
+    using slot_type = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = ring_iterator<false>;
+    using const_iterator = ring_iterator<true>;
+    using span_type = my_span<T>;
+    using const_span_type = my_span<const T>;
+
+public:
+
+    // The capacity is rounded up to a power of two. The overwrite_oldest mode needs a non zero capacity
+    explicit my_ring_buffer(size_t capacity = 0, ring_overflow overflow = ring_overflow::grow)
+        : m_overflow(overflow) {
+        if (overflow == ring_overflow::overwrite_oldest && capacity == 0)
+            throw std::invalid_argument("overwriting ring buffer needs a capacity");
+        if (capacity) allocate(round_up_pow2(capacity));
+    }
+
+    my_ring_buffer(std::initializer_list<T> lst) : my_ring_buffer(lst.size()) {
+        for (auto& v : lst) push_back(v);
+    }
+
+    my_ring_buffer(const my_ring_buffer& rhs) : my_ring_buffer(rhs.capacity(), rhs.m_overflow) {
+        for (size_t i = 0; i < rhs.m_size; ++i) push_back(rhs[i]);
+    }
+
+    my_ring_buffer(my_ring_buffer&& rhs) noexcept
+        : m_slots(std::move(rhs.m_slots)), m_head(rhs.m_head), m_size(rhs.m_size), m_overflow(rhs.m_overflow) {
+        rhs.m_head = 0;
+        rhs.m_size = 0;
+    }
+
+    ~my_ring_buffer() noexcept {
+        clear();
+    }
+
+    my_ring_buffer& operator = (const my_ring_buffer& rhs) {
+        my_ring_buffer tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_ring_buffer& operator = (my_ring_buffer&& rhs) noexcept {
+        my_ring_buffer tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(my_ring_buffer& rhs) noexcept {
+        m_slots.swap(rhs.m_slots);
+        std::swap(m_head, rhs.m_head);
+        std::swap(m_size, rhs.m_size);
+        std::swap(m_overflow, rhs.m_overflow);
+    }
+
+    size_t size() const { return m_size; }
+
+    size_t capacity() const { return m_slots.size(); }
+
+    bool is_empty() const { return m_size == 0; }
+
+    bool is_full() const { return m_size == capacity(); }
+
+    ring_overflow overflow() const { return m_overflow; }
+
+    // Ensures capacity of at least new_cap, never shrinks
+    void reserve(size_t new_cap) {
+        if (new_cap > capacity()) reallocate(round_up_pow2(new_cap));
+    }
+
+    T& operator [] (size_t i) { return *slot(m_head + i); }
+
+    const T& operator [] (size_t i) const { return *slot(m_head + i); }
+
+    T& at (size_t pos) {
+        if (pos >= m_size) throw std::out_of_range("pos is out of range");
+        return (*this)[pos];
+    }
+
+    const T& at (size_t pos) const {
+        if (pos >= m_size) throw std::out_of_range("pos is out of range");
+        return (*this)[pos];
+    }
+
+    T& front() { return (*this)[0]; }
+
+    const T& front() const { return (*this)[0]; }
+
+    T& back() { return (*this)[m_size - 1]; }
+
+    const T& back() const { return (*this)[m_size - 1]; }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template< class... Args >
+    T& emplace_back( Args&&... args ) {
+        if (!is_full()) return construct_back(std::forward<Args>(args)...);
+        // args may refer to an element, which making room moves or destroys
+        T value{ std::forward<Args>(args)... };
+        if (m_overflow == ring_overflow::grow || capacity() == 0) {
+            reallocate(capacity() ? capacity() * 2 : 1);
+        } else {
+            pop_front();
+        }
+        return construct_back(std::move(value));
+    }
+
+    void push_front(const T& value) { emplace_front(value); }
+
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    // In the overwrite_oldest mode a full buffer drops its back element, the one pushed last to the back
+    template< class... Args >
+    T& emplace_front( Args&&... args ) {
+        if (!is_full()) return construct_front(std::forward<Args>(args)...);
+        T value{ std::forward<Args>(args)... };
+        if (m_overflow == ring_overflow::grow || capacity() == 0) {
+            reallocate(capacity() ? capacity() * 2 : 1);
+        } else {
+            pop_back();
+        }
+        return construct_front(std::move(value));
+    }
+
+    void pop_front() {
+        if (!is_empty()) {
+            slot(m_head)->~T();
+            m_head = (m_head + 1) & mask();
+            --m_size;
+        }
+    }
+
+    void pop_back() {
+        if (!is_empty()) {
+            slot(m_head + m_size - 1)->~T();
+            --m_size;
+        }
+    }
+
+    void clear() {
+        while (!is_empty()) pop_back();
+        m_head = 0;
+    }
+
+    // The content as two contiguous parts in order: [head, end of storage) and the wrapped part from the
+    // storage start. The second span is empty when the content doesn't wrap.
+    // Suitable for vectorized loops or, for trivially copyable T, as a two element iovec for writev().
+    std::pair<span_type, span_type> as_spans() {
+        auto first = std::min(m_size, capacity() - m_head);
+        return {span_type(slot(m_head), first), span_type(m_size > first ? slot(0) : nullptr, m_size - first)};
+    }
+
+    std::pair<const_span_type, const_span_type> as_spans() const {
+        auto first = std::min(m_size, capacity() - m_head);
+        return {const_span_type(slot(m_head), first), const_span_type(m_size > first ? slot(0) : nullptr, m_size - first)};
+    }
+
+    // Moves the content to the start of the storage, as_spans().first holds everything afterwards
+    void linearize() {
+        if (m_head != 0) reallocate(capacity());
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, m_size); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+
+    const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator cend() const noexcept { return const_iterator(this, m_size); }
+
+private:
+    static size_t round_up_pow2(size_t n) {
+        size_t result = 1;
+        while (result < n) result <<= 1;
+        return result;
+    }
+
+    size_t mask() const { return capacity() - 1; }
+
+    T* slot(size_t physical) {
+        return std::launder(reinterpret_cast<T*>(&m_slots[physical & mask()]));
+    }
+
+    const T* slot(size_t physical) const {
+        return std::launder(reinterpret_cast<const T*>(&m_slots[physical & mask()]));
+    }
+
+    void allocate(size_t capacity) {
+        m_slots.reserve(capacity);
+        m_slots.resize(capacity);
+    }
+
+    // Constructs an element in the free slot after the back, there must be one
+    template< class... Args >
+    T& construct_back( Args&&... args ) {
+        auto p = new (&m_slots[(m_head + m_size) & mask()]) T{ std::forward<Args>(args)... };
+        ++m_size;
+        return *p;
+    }
+
+    template< class... Args >
+    T& construct_front( Args&&... args ) {
+        auto head = (m_head - 1) & mask();
+        auto p = new (&m_slots[head]) T{ std::forward<Args>(args)... };
+        m_head = head;
+        ++m_size;
+        return *p;
+    }
+
+    // Moves the content into new storage of new_cap slots, starting at slot 0
+    void reallocate(size_t new_cap) {
+        my_ring_buffer fresh;
+        fresh.allocate(new_cap);
+        fresh.m_overflow = m_overflow;
+        for (size_t i = 0; i < m_size; ++i) {
+            new (&fresh.m_slots[i]) T{ std::move((*this)[i]) };
+            ++fresh.m_size;
+        }
+        swap(fresh);
+    }
+
+    //
+    // Random access iterator over the logical order, wraps around the end of the storage
+    //
+    template <bool Const>
+    class ring_iterator {
+        using owner_type = std::conditional_t<Const, const my_ring_buffer, my_ring_buffer>;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+    public:
+        ring_iterator() {}
+        ring_iterator(owner_type* owner_p, size_t pos) : m_owner_p(owner_p), m_pos(pos) {}
+        operator ring_iterator<true> () const { return ring_iterator<true>(m_owner_p, m_pos); }
+        ring_iterator operator ++ (int) { return ring_iterator(m_owner_p, m_pos++); }
+        ring_iterator& operator ++ () { ++m_pos; return *this; }
+        ring_iterator operator -- (int) { return ring_iterator(m_owner_p, m_pos--); }
+        ring_iterator& operator -- () { --m_pos; return *this; }
+        difference_type operator - (ring_iterator rhs) const { return static_cast<difference_type>(m_pos - rhs.m_pos); }
+        ring_iterator& operator += (difference_type n) { m_pos += n; return *this; }
+        ring_iterator& operator -= (difference_type n) { m_pos -= n; return *this; }
+        ring_iterator operator - (difference_type n) const { return ring_iterator(m_owner_p, m_pos - n); }
+        ring_iterator operator + (difference_type n) const { return ring_iterator(m_owner_p, m_pos + n); }
+        pointer operator -> () const { return &(*m_owner_p)[m_pos]; }
+        reference operator * () const { return (*m_owner_p)[m_pos]; }
+        reference operator [] (difference_type n) const { return (*m_owner_p)[m_pos + n]; }
+        bool operator == (ring_iterator rhs) const { return m_pos == rhs.m_pos; }
+        bool operator != (ring_iterator rhs) const { return m_pos != rhs.m_pos; }
+        bool operator < (ring_iterator rhs) const { return m_pos < rhs.m_pos; }
+        bool operator > (ring_iterator rhs) const { return m_pos > rhs.m_pos; }
+        bool operator <= (ring_iterator rhs) const { return m_pos <= rhs.m_pos; }
+        bool operator >= (ring_iterator rhs) const { return m_pos >= rhs.m_pos; }
+    private:
+        owner_type* m_owner_p = nullptr;
+        size_t m_pos = 0;
+    };
+
+private:
+    my_vector<slot_type> m_slots;
+    size_t m_head = 0;
+    size_t m_size = 0;
+    ring_overflow m_overflow = ring_overflow::grow;
+};
+
+}
+
+#endif // MY_RING_BUFFER_H
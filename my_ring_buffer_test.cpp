@@ -0,0 +1,139 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_ring_buffer.h"
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <string>
+
+using namespace cpp_training;
+
+TEST(MyRingBufferTest, Construction) {
+    my_ring_buffer<int> empty;
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_EQ(empty.capacity(), 0);
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_THROW(empty.at(0), std::out_of_range);
+
+    my_ring_buffer<int> rb(5);
+    EXPECT_EQ(rb.capacity(), 8);
+    EXPECT_EQ(rb.size(), 0);
+
+    my_ring_buffer<std::string> strs {"a", "b", "c"};
+    EXPECT_EQ(strs.size(), 3);
+    EXPECT_EQ(strs.capacity(), 4);
+    EXPECT_EQ(strs.front(), "a");
+    EXPECT_EQ(strs.back(), "c");
+
+    my_ring_buffer<std::string> copy(strs);
+    EXPECT_EQ(copy[1], "b");
+    my_ring_buffer<std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(copy.size(), 0);
+
+    EXPECT_THROW(my_ring_buffer<int>(0, ring_overflow::overwrite_oldest), std::invalid_argument);
+}
+
+TEST(MyRingBufferTest, Fifo) {
+    my_ring_buffer<std::string> rb(4);
+    std::deque<std::string> model;
+    for (int round = 0; round < 10; ++round) {
+        rb.push_back(std::to_string(round));
+        rb.push_back(std::to_string(round + 100));
+        model.push_back(std::to_string(round));
+        model.push_back(std::to_string(round + 100));
+        EXPECT_EQ(rb.front(), model.front());
+        rb.pop_front();
+        model.pop_front();
+    }
+    EXPECT_EQ(rb.size(), 10);
+    EXPECT_EQ(rb.capacity(), 16);
+    EXPECT_TRUE(std::equal(rb.begin(), rb.end(), model.begin(), model.end()));
+    EXPECT_EQ(rb.back(), "109");
+
+    rb.push_front("first");
+    EXPECT_EQ(rb[0], "first");
+    EXPECT_EQ(rb[1], model.front());
+    rb.pop_back();
+    EXPECT_EQ(rb.back(), "9");
+    rb.clear();
+    EXPECT_TRUE(rb.is_empty());
+}
+
+TEST(MyRingBufferTest, Wrapping) {
+    my_ring_buffer<int> rb(8);
+    for (int i = 0; i < 6; ++i) rb.push_back(i);
+    for (int i = 0; i < 4; ++i) rb.pop_front();
+    for (int i = 6; i < 12; ++i) rb.push_back(i);
+    EXPECT_EQ(rb.capacity(), 8);
+    EXPECT_EQ(rb.size(), 8);
+    EXPECT_TRUE(rb.is_full());
+
+    // Iterators follow the logical order
+    EXPECT_TRUE(std::equal(rb.begin(), rb.end(), my_vector<int>{4, 5, 6, 7, 8, 9, 10, 11}.begin()));
+    EXPECT_EQ(rb.end() - rb.begin(), 8);
+    EXPECT_EQ(*(rb.begin() + 5), 9);
+    EXPECT_EQ(std::accumulate(rb.cbegin(), rb.cend(), 0), 60);
+    EXPECT_TRUE(std::is_sorted(rb.begin(), rb.end()));
+
+    auto spans = rb.as_spans();
+    EXPECT_EQ(spans.first.size(), 4);
+    EXPECT_EQ(spans.second.size(), 4);
+    EXPECT_EQ(spans.first[0], 4);
+    EXPECT_EQ(spans.second[0], 8);
+
+    rb.linearize();
+    auto lin = rb.as_spans();
+    EXPECT_EQ(lin.first.size(), 8);
+    EXPECT_TRUE(lin.second.is_empty());
+    EXPECT_EQ(lin.first[7], 11);
+
+    // Grows by reordering into new storage
+    rb.push_front(3);
+    EXPECT_EQ(rb.capacity(), 16);
+    EXPECT_EQ(rb[0], 3);
+    EXPECT_EQ(rb[8], 11);
+
+    std::sort(rb.begin(), rb.end(), std::greater<int>());
+    EXPECT_EQ(rb.front(), 11);
+}
+
+TEST(MyRingBufferTest, OverwriteOldest) {
+    my_ring_buffer<int> rb(4, ring_overflow::overwrite_oldest);
+    for (int i = 0; i < 10; ++i) rb.push_back(i);
+    EXPECT_EQ(rb.size(), 4);
+    EXPECT_EQ(rb.capacity(), 4);
+    EXPECT_EQ(rb.front(), 6);
+    EXPECT_EQ(rb.back(), 9);
+
+    rb.push_front(5);
+    EXPECT_EQ(rb.front(), 5);
+    EXPECT_EQ(rb.back(), 8);
+
+    const auto& crb = rb;
+    auto spans = crb.as_spans();
+    EXPECT_EQ(spans.first.size() + spans.second.size(), 4);
+}
+
+TEST(MyRingBufferTest, PushOwnElementWhenFull) {
+    // The pushed element is the one reallocation moves or overwriting drops
+    my_ring_buffer<std::string> grow(2);
+    grow.push_back(std::string(40, 'a'));
+    grow.push_back(std::string(40, 'b'));
+    grow.push_back(grow[0]);
+    grow.push_front(grow.back());
+    EXPECT_EQ(grow.size(), 4);
+    EXPECT_EQ(grow[0], std::string(40, 'a'));
+    EXPECT_EQ(grow[3], std::string(40, 'a'));
+
+    my_ring_buffer<std::string> ring(2, ring_overflow::overwrite_oldest);
+    ring.push_back(std::string(40, 'a'));
+    ring.push_back(std::string(40, 'b'));
+    ring.push_back(ring.front());
+    EXPECT_EQ(ring.front(), std::string(40, 'b'));
+    EXPECT_EQ(ring.back(), std::string(40, 'a'));
+    ring.push_front(ring.back());
+    EXPECT_EQ(ring.front(), std::string(40, 'a'));
+    EXPECT_EQ(ring.back(), std::string(40, 'b'));
+}
@@ -0,0 +1,444 @@
+#ifndef MY_ROPE_H
+#define MY_ROPE_H
+
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "my_vector.h"
+#include "my_span.h"
+
+namespace cpp_training {
+
+// Sequence stored as a height balanced (AVL) binary tree whose leaves are my_vectors of up to about 4 KB.
+// Inner nodes only keep the size and height of their subtree, so positions are found by walking down.
+// Everything is built on two O(log n) primitives, join (concatenate two trees) and split (cut at a position):
+// inserting or erasing a range in the middle costs O(log n) plus the range itself, never moves the rest.
+// Small inserts into a leaf with room go straight into it. Where a split cut a leaf or a join meets two leaves,
+// neighbours which fit in one leaf are merged, so two adjacent leaves always hold more than LeafCapacity values
+// and erasing or splitting doesn't leave many tiny leaves behind.
+template <typename T>
+class my_rope {
+    struct node {
+        size_t size = 0;
+        int height = 0;                     // Leaves have height 0
+        std::unique_ptr<node> left, right;
+        my_vector<T> leaf;
+
+        bool is_leaf() const { return !left; }
+    };
+
+    using node_ptr = std::unique_ptr<node>;
+
+    class rope_iterator;
+
+public:
+    static constexpr size_t LeafBytes = 4096;
+    static constexpr size_t LeafCapacity = LeafBytes / sizeof(T) ? LeafBytes / sizeof(T) : 1;
+    using value_type = T;
+    using const_iterator = rope_iterator;
+    using span_type = my_span<const T>;
+
+public:
+
+    my_rope() {
+    }
+
+    my_rope(std::initializer_list<T> lst) : m_root(build(lst.begin(), lst.size())) {
+    }
+
+    explicit my_rope(const my_vector<T>& values) : m_root(build(values.data(), values.size())) {
+    }
+
+    my_rope(const my_rope& rhs) : m_root(copy(rhs.m_root.get())) {
+    }
+
+    my_rope(my_rope&& rhs) noexcept = default;
+
+    my_rope& operator = (const my_rope& rhs) {
+        my_rope tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_rope& operator = (my_rope&& rhs) noexcept = default;
+
+    void swap(my_rope& rhs) noexcept {
+        m_root.swap(rhs.m_root);
+    }
+
+    size_t size() const { return size_of(m_root); }
+
+    bool is_empty() const { return !m_root; }
+
+    // Height of the tree, at most about 1.44 * log2(number of leaves)
+    int height() const { return height_of(m_root); }
+
+    const T& operator [] (size_t i) const {
+        auto found = locate(i);
+        return found.first->leaf[i - found.second];
+    }
+
+    T& operator [] (size_t i) {
+        auto found = locate(i);
+        return found.first->leaf[i - found.second];
+    }
+
+    const T& at(size_t i) const {
+        if (i >= size()) throw std::out_of_range("pos is out of range");
+        return (*this)[i];
+    }
+
+    T& at(size_t i) {
+        if (i >= size()) throw std::out_of_range("pos is out of range");
+        return (*this)[i];
+    }
+
+    void push_back(const T& value) { insert(size(), &value, 1); }
+
+    void insert(size_t pos, const T& value) { insert(pos, &value, 1); }
+
+    void insert(size_t pos, const my_vector<T>& values) { insert(pos, values.data(), values.size()); }
+
+    // Inserts values [0, count) before pos. values may point into this rope
+    void insert(size_t pos, const T* values, size_t count) {
+        if (pos > size()) throw std::out_of_range("pos is out of range");
+        if (count == 0) return;
+        if (insert_into_leaf(pos, values, count)) return;
+        // Built before the split, which cuts and merges the leaves values may point into
+        auto middle = build(values, count);
+        auto parts = split_merged(std::move(m_root), pos);
+        m_root = join_merged(join_merged(std::move(parts.first), std::move(middle)), std::move(parts.second));
+    }
+
+    // Erases [pos, pos + count)
+    void erase(size_t pos, size_t count = 1) {
+        if (pos + count > size()) throw std::out_of_range("pos is out of range");
+        if (count == 0) return;
+        auto tail = split_merged(std::move(m_root), pos + count);
+        auto head = split_merged(std::move(tail.first), pos);
+        m_root = join_merged(std::move(head.first), std::move(tail.second));
+    }
+
+    // Appends the content of rhs, which is left empty, O(log n)
+    void append(my_rope&& rhs) {
+        m_root = join_merged(std::move(m_root), std::move(rhs.m_root));
+    }
+
+    // Moves [pos, size()) out into the returned rope, O(log n)
+    my_rope split_off(size_t pos) {
+        if (pos > size()) throw std::out_of_range("pos is out of range");
+        auto parts = split_merged(std::move(m_root), pos);
+        m_root = std::move(parts.first);
+        my_rope result;
+        result.m_root = std::move(parts.second);
+        return result;
+    }
+
+    void clear() { m_root.reset(); }
+
+    // Calls fn(my_span<const T>) for every leaf in order
+    template <typename Fn>
+    void for_each_leaf(Fn&& fn) const {
+        for_each_leaf(m_root.get(), fn);
+    }
+
+    // Flattens into one my_vector
+    my_vector<T> to_vector() const {
+        my_vector<T> result;
+        result.reserve(size());
+        for_each_leaf([&result](span_type leaf) {
+            for (auto& value : leaf) result.push_back(value);
+        });
+        return result;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    const_iterator cbegin() const { return begin(); }
+
+    const_iterator cend() const { return end(); }
+
+private:
+    static size_t size_of(const node_ptr& n) { return n ? n->size : 0; }
+
+    static int height_of(const node_ptr& n) { return n ? n->height : -1; }
+
+    static void update(node& n) {
+        n.size = n.left->size + n.right->size;
+        n.height = std::max(n.left->height, n.right->height) + 1;
+    }
+
+    static node_ptr make_leaf(const T* values, size_t count) {
+        node_ptr n(new node);
+        n->leaf.reserve(count);
+        for (size_t i = 0; i < count; ++i) n->leaf.push_back(values[i]);
+        n->size = count;
+        return n;
+    }
+
+    static node_ptr make_parent(node_ptr left, node_ptr right) {
+        node_ptr n(new node);
+        n->left = std::move(left);
+        n->right = std::move(right);
+        update(*n);
+        return n;
+    }
+
+    // Balanced tree of full leaves (the last one may be partial) over values [0, count)
+    static node_ptr build(const T* values, size_t count) {
+        if (count == 0) return nullptr;
+        auto leaves = (count + LeafCapacity - 1) / LeafCapacity;
+        if (leaves == 1) return make_leaf(values, count);
+        auto left_count = leaves / 2 * LeafCapacity;
+        return make_parent(build(values, left_count), build(values + left_count, count - left_count));
+    }
+
+    static node_ptr copy(const node* n) {
+        if (!n) return nullptr;
+        if (n->is_leaf()) return make_leaf(n->leaf.data(), n->leaf.size());
+        return make_parent(copy(n->left.get()), copy(n->right.get()));
+    }
+
+    static node_ptr rotate_left(node_ptr n) {
+        auto r = std::move(n->right);
+        n->right = std::move(r->left);
+        update(*n);
+        r->left = std::move(n);
+        update(*r);
+        return r;
+    }
+
+    static node_ptr rotate_right(node_ptr n) {
+        auto l = std::move(n->left);
+        n->left = std::move(l->right);
+        update(*n);
+        l->right = std::move(n);
+        update(*l);
+        return l;
+    }
+
+    // Restores the AVL property of n, whose subtrees differ in height by at most 2
+    static node_ptr rebalance(node_ptr n) {
+        update(*n);
+        auto balance = n->left->height - n->right->height;
+        if (balance > 1) {
+            if (n->left->left->height < n->left->right->height) n->left = rotate_left(std::move(n->left));
+            return rotate_right(std::move(n));
+        }
+        if (balance < -1) {
+            if (n->right->right->height < n->right->left->height) n->right = rotate_right(std::move(n->right));
+            return rotate_left(std::move(n));
+        }
+        return n;
+    }
+
+    // Concatenation, O(|height(l) - height(r)|). Descends the higher tree along its inner edge
+    // to a subtree of about the height of the other one and rebalances on the way back
+    static node_ptr join(node_ptr l, node_ptr r) {
+        if (!l) return r;
+        if (!r) return l;
+        if (l->is_leaf() && r->is_leaf() && l->size + r->size <= LeafCapacity) {
+            // Keeps splits from leaving many tiny leaves behind
+            for (auto& value : r->leaf) l->leaf.push_back(std::move(value));
+            l->size = l->leaf.size();
+            return l;
+        }
+        if (l->height > r->height + 1) {
+            l->right = join(std::move(l->right), std::move(r));
+            return rebalance(std::move(l));
+        }
+        if (r->height > l->height + 1) {
+            r->left = join(std::move(l), std::move(r->left));
+            return rebalance(std::move(r));
+        }
+        return make_parent(std::move(l), std::move(r));
+    }
+
+    // Cuts n into [0, pos) and [pos, size), O(log n): the joins along the path telescope
+    static std::pair<node_ptr, node_ptr> split(node_ptr n, size_t pos) {
+        if (!n) return {nullptr, nullptr};
+        if (pos == 0) return {nullptr, std::move(n)};
+        if (pos == n->size) return {std::move(n), nullptr};
+        if (n->is_leaf()) {
+            auto right = make_leaf(n->leaf.data() + pos, n->size - pos);
+            n->leaf.erase(n->leaf.cbegin() + pos, n->leaf.cend());
+            n->size = pos;
+            return {std::move(n), std::move(right)};
+        }
+        auto left_size = n->left->size;
+        if (pos <= left_size) {
+            auto parts = split(std::move(n->left), pos);
+            return {std::move(parts.first), join(std::move(parts.second), std::move(n->right))};
+        }
+        auto parts = split(std::move(n->right), pos - left_size);
+        return {join(std::move(n->left), std::move(parts.first)), std::move(parts.second)};
+    }
+
+    // First leaf of n: the rest of the tree, null if n is a leaf, and the leaf. O(log n)
+    static std::pair<node_ptr, node_ptr> pop_first_leaf(node_ptr n) {
+        if (n->is_leaf()) return {nullptr, std::move(n)};
+        auto parts = pop_first_leaf(std::move(n->left));
+        if (!parts.first) return {std::move(n->right), std::move(parts.second)};
+        n->left = std::move(parts.first);
+        return {rebalance(std::move(n)), std::move(parts.second)};
+    }
+
+    // Last leaf of n: the rest of the tree, null if n is a leaf, and the leaf. O(log n)
+    static std::pair<node_ptr, node_ptr> pop_last_leaf(node_ptr n) {
+        if (n->is_leaf()) return {nullptr, std::move(n)};
+        auto parts = pop_last_leaf(std::move(n->right));
+        if (!parts.first) return {std::move(n->left), std::move(parts.second)};
+        n->right = std::move(parts.first);
+        return {rebalance(std::move(n)), std::move(parts.second)};
+    }
+
+    static const node& first_leaf(const node& n) { return n.is_leaf() ? n : first_leaf(*n.left); }
+
+    static const node& last_leaf(const node& n) { return n.is_leaf() ? n : last_leaf(*n.right); }
+
+    // Moves the values of leaf to the end of the last leaf of n
+    static void append_to_last_leaf(node& n, node& leaf) {
+        n.size += leaf.size;
+        if (!n.is_leaf()) return append_to_last_leaf(*n.right, leaf);
+        for (auto& value : leaf.leaf) n.leaf.push_back(std::move(value));
+    }
+
+    // join() which first merges the last leaf of l and the first leaf of r when they fit in one, O(log n).
+    // One merge restores the invariant of adjacent leaves if both trees have it
+    static node_ptr join_merged(node_ptr l, node_ptr r) {
+        if (l && r && last_leaf(*l).size + first_leaf(*r).size <= LeafCapacity) {
+            auto parts = pop_first_leaf(std::move(r));
+            append_to_last_leaf(*l, *parts.second);
+            r = std::move(parts.first);
+        }
+        return join(std::move(l), std::move(r));
+    }
+
+    // split() which merges the leaves it cut with their neighbours when they fit in one, O(log n)
+    static std::pair<node_ptr, node_ptr> split_merged(node_ptr n, size_t pos) {
+        auto parts = split(std::move(n), pos);
+        if (parts.first && !parts.first->is_leaf()) {
+            auto last = pop_last_leaf(std::move(parts.first));
+            parts.first = join_merged(std::move(last.first), std::move(last.second));
+        }
+        if (parts.second && !parts.second->is_leaf()) {
+            auto first = pop_first_leaf(std::move(parts.second));
+            parts.second = join_merged(std::move(first.second), std::move(first.first));
+        }
+        return parts;
+    }
+
+    // Leaf holding position i (the last leaf for i == size()) and the position of its first element
+    std::pair<node*, size_t> locate(size_t i) const {
+        node* n = m_root.get();
+        size_t start = 0;
+        while (!n->is_leaf()) {
+            if (i - start < n->left->size) {
+                n = n->left.get();
+            } else {
+                start += n->left->size;
+                n = n->right.get();
+            }
+        }
+        return {n, start};
+    }
+
+    // Inserts into the leaf at pos when it has room, returns false otherwise
+    bool insert_into_leaf(size_t pos, const T* values, size_t count) {
+        if (!m_root) return false;
+        my_vector<node*> path;
+        node* n = m_root.get();
+        size_t start = 0;
+        while (!n->is_leaf()) {
+            path.push_back(n);
+            if (pos - start < n->left->size) {
+                n = n->left.get();
+            } else {
+                start += n->left->size;
+                n = n->right.get();
+            }
+        }
+        if (n->size + count > LeafCapacity) return false;
+        std::less<const T*> less;
+        if (!less(values, n->leaf.data()) && less(values, n->leaf.data() + n->leaf.size())) {
+            // The leaf may reallocate before it reads values
+            my_vector<T> copy(values, values + count);
+            n->leaf.insert(n->leaf.cbegin() + (pos - start), copy.data(), copy.data() + count);
+        } else {
+            n->leaf.insert(n->leaf.cbegin() + (pos - start), values, values + count);
+        }
+        n->size += count;
+        for (auto p : path) p->size += count;
+        return true;
+    }
+
+    template <typename Fn>
+    static void for_each_leaf(const node* n, Fn& fn) {
+        if (!n) return;
+        if (n->is_leaf()) {
+            fn(span_type(n->leaf.data(), n->leaf.size()));
+        } else {
+            for_each_leaf(n->left.get(), fn);
+            for_each_leaf(n->right.get(), fn);
+        }
+    }
+
+    //
+    // Forward iterator which remembers its leaf: stepping inside a leaf is O(1), into the next leaf O(log n)
+    //
+    class rope_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using reference = const T&;
+        using pointer = const T*;
+    public:
+        rope_iterator() {}
+        rope_iterator(const my_rope* owner_p, size_t pos) : m_owner_p(owner_p), m_pos(pos) { enter_leaf(); }
+        size_t index() const { return m_pos; }
+        // The contiguous rest of the current leaf, from this position on
+        span_type leaf_span() const { return span_type(m_leaf_p + (m_pos - m_leaf_begin), m_leaf_end - m_pos); }
+        // Moves to the start of the next leaf
+        rope_iterator& next_leaf() { m_pos = m_leaf_end; enter_leaf(); return *this; }
+        rope_iterator operator ++ (int) { auto result = *this; ++*this; return result; }
+        rope_iterator& operator ++ () {
+            if (++m_pos == m_leaf_end) enter_leaf();
+            return *this;
+        }
+        reference operator * () const { return m_leaf_p[m_pos - m_leaf_begin]; }
+        pointer operator -> () const { return &**this; }
+        bool operator == (const rope_iterator& rhs) const { return m_pos == rhs.m_pos; }
+        bool operator != (const rope_iterator& rhs) const { return m_pos != rhs.m_pos; }
+    private:
+        void enter_leaf() {
+            if (m_pos >= m_owner_p->size()) {
+                m_leaf_p = nullptr;
+                m_leaf_begin = m_leaf_end = m_pos;
+                return;
+            }
+            auto found = m_owner_p->locate(m_pos);
+            m_leaf_p = found.first->leaf.data();
+            m_leaf_begin = found.second;
+            m_leaf_end = found.second + found.first->size;
+        }
+    private:
+        const my_rope* m_owner_p = nullptr;
+        size_t m_pos = 0;
+        const T* m_leaf_p = nullptr;
+        size_t m_leaf_begin = 0;
+        size_t m_leaf_end = 0;
+    };
+
+private:
+    node_ptr m_root;
+};
+
+}
+
+#endif // MY_ROPE_H
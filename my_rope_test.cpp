@@ -0,0 +1,187 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_rope.h"
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cpp_training;
+
+namespace {
+
+my_vector<int> sequence(int first, int count) {
+    my_vector<int> result;
+    for (int i = 0; i < count; ++i) result.push_back(first + i);
+    return result;
+}
+
+template <typename T>
+void expect_balanced(const my_rope<T>& rope) {
+    auto leaves = 0;
+    rope.for_each_leaf([&leaves](my_span<const T>) { ++leaves; });
+    EXPECT_LE(rope.height(), 1.45 * std::log2(leaves + 2) + 1) << leaves << " leaves";
+}
+
+// No two adjacent leaves fit in one
+template <typename T>
+void expect_merged(const my_rope<T>& rope) {
+    size_t previous = my_rope<T>::LeafCapacity, leaves = 0;
+    rope.for_each_leaf([&](my_span<const T> leaf) {
+        EXPECT_GT(previous + leaf.size(), my_rope<T>::LeafCapacity) << "leaf " << leaves;
+        previous = leaf.size();
+        ++leaves;
+    });
+}
+
+}
+
+TEST(MyRopeTest, Basics) {
+    my_rope<std::string> rope {"a", "b", "c"};
+    EXPECT_EQ(rope.size(), 3);
+    EXPECT_EQ(rope[1], "b");
+    rope.insert(1, std::string("x"));
+    rope.push_back("d");
+    rope[0] = "A";
+    EXPECT_EQ(rope.to_vector(), (my_vector<std::string>{"A", "x", "b", "c", "d"}));
+    rope.erase(1, 2);
+    EXPECT_EQ(rope.to_vector(), (my_vector<std::string>{"A", "c", "d"}));
+    EXPECT_THROW(rope.at(3), std::out_of_range);
+    EXPECT_THROW(rope.erase(2, 2), std::out_of_range);
+    EXPECT_THROW(rope.insert(4, "y"), std::out_of_range);
+
+    my_rope<std::string> copy(rope);
+    rope.clear();
+    EXPECT_TRUE(rope.is_empty());
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_TRUE(rope.begin() == rope.end());
+}
+
+TEST(MyRopeTest, InsertOwnElements) {
+    // Heap allocated strings, so a read of a moved or freed element shows up
+    const std::string a(40, 'a'), b(40, 'b');
+    my_rope<std::string> rope {a, b};
+    // Room in the leaf, which reallocates
+    for (int i = 0; i < 20; ++i) rope.push_back(rope[0]);
+    rope.insert(1, rope[rope.size() - 1]);
+    EXPECT_EQ(rope.size(), 23);
+    EXPECT_EQ(rope[1], a);
+    EXPECT_EQ(rope[2], b);
+    EXPECT_EQ(rope[22], a);
+
+    // Full leaves: the insert splits the leaf holding the element
+    my_rope<std::string> big;
+    for (size_t i = 0; i < 3 * my_rope<std::string>::LeafCapacity; ++i) big.push_back(i % 2 ? a : b);
+    big.insert(100, big[101]);
+    big.insert(0, big[big.size() - 1]);
+    EXPECT_EQ(big.size(), 3 * my_rope<std::string>::LeafCapacity + 2);
+    EXPECT_EQ(big[0], a);
+    EXPECT_EQ(big[101], a);
+    EXPECT_EQ(big[102], b);
+    EXPECT_EQ(big[103], a);
+}
+
+TEST(MyRopeTest, LargeMiddleInsert) {
+    constexpr int Count = 1000000;
+    my_rope<int> rope(sequence(0, Count));
+    expect_balanced(rope);
+    EXPECT_EQ(rope.size(), Count);
+    EXPECT_EQ(rope[Count / 2], Count / 2);
+
+    rope.insert(Count / 2, sequence(-5000, 5000));
+    EXPECT_EQ(rope.size(), Count + 5000);
+    EXPECT_EQ(rope[Count / 2 - 1], Count / 2 - 1);
+    EXPECT_EQ(rope[Count / 2], -5000);
+    EXPECT_EQ(rope[Count / 2 + 5000], Count / 2);
+    expect_balanced(rope);
+
+    rope.erase(10, Count);
+    EXPECT_EQ(rope.size(), 5000);
+    EXPECT_EQ(rope[9], 9);
+    EXPECT_EQ(rope[10], Count - 4990);
+}
+
+TEST(MyRopeTest, SplitAndAppend) {
+    my_rope<int> rope(sequence(0, 100000));
+    auto tail = rope.split_off(30000);
+    EXPECT_EQ(rope.size(), 30000);
+    EXPECT_EQ(tail.size(), 70000);
+    EXPECT_EQ(tail[0], 30000);
+    expect_balanced(rope);
+    expect_balanced(tail);
+
+    my_rope<int> small {-1, -2};
+    small.append(std::move(rope));
+    EXPECT_TRUE(rope.is_empty());
+    small.append(std::move(tail));
+    EXPECT_EQ(small.size(), 100002);
+    EXPECT_EQ(small[2], 0);
+    EXPECT_EQ(small[100001], 99999);
+    expect_balanced(small);
+    expect_merged(small);
+
+    // Cutting small pieces off both ends and gluing them back
+    for (size_t pos = 1; pos < 20000; pos += 997) {
+        auto piece = small.split_off(pos);
+        auto rest = piece.split_off(std::min<size_t>(5, piece.size()));
+        expect_merged(small);
+        expect_merged(piece);
+        expect_merged(rest);
+        small.append(std::move(piece));
+        small.append(std::move(rest));
+    }
+    EXPECT_EQ(small.size(), 100002);
+    EXPECT_EQ(small[100001], 99999);
+    expect_merged(small);
+}
+
+TEST(MyRopeTest, LeafIterator) {
+    my_rope<int> rope(sequence(0, 10000));
+    size_t total = 0;
+    int expected = 0;
+    for (auto it = rope.begin(); it != rope.end(); it.next_leaf()) {
+        auto span = it.leaf_span();
+        EXPECT_LE(span.size(), my_rope<int>::LeafCapacity);
+        for (auto value : span) ASSERT_EQ(value, expected++);
+        total += span.size();
+    }
+    EXPECT_EQ(total, rope.size());
+
+    expected = 0;
+    for (auto value : rope) ASSERT_EQ(value, expected++);
+    auto it = rope.begin();
+    for (int i = 0; i < 1500; ++i) ++it;
+    EXPECT_EQ(*it, 1500);
+    EXPECT_EQ(it.leaf_span().front(), 1500);
+}
+
+TEST(MyRopeTest, MatchesVector) {
+    my_rope<int> rope;
+    std::vector<int> model;
+    std::mt19937 gen(13);
+    for (int i = 0; i < 3000; ++i) {
+        auto pos = gen() % (model.size() + 1);
+        if (gen() % 3 || model.empty()) {
+            auto count = gen() % 8 ? gen() % 10 + 1 : gen() % 3000;
+            auto values = sequence(static_cast<int>(gen() % 100000), static_cast<int>(count));
+            rope.insert(pos, values);
+            model.insert(model.begin() + pos, values.data(), values.data() + values.size());
+        } else {
+            auto count = std::min<size_t>(gen() % 2000, model.size() - std::min(pos, model.size() - 1));
+            pos = std::min(pos, model.size() - count);
+            rope.erase(pos, count);
+            model.erase(model.begin() + pos, model.begin() + pos + count);
+        }
+        ASSERT_EQ(rope.size(), model.size());
+        if (i % 100 == 0) expect_merged(rope);
+    }
+    auto flat = rope.to_vector();
+    ASSERT_EQ(flat.size(), model.size());
+    for (size_t i = 0; i < model.size(); ++i) {
+        ASSERT_EQ(flat[i], model[i]);
+        ASSERT_EQ(rope[i], model[i]);
+    }
+    expect_balanced(rope);
+    expect_merged(rope);
+}
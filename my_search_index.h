@@ -0,0 +1,310 @@
+#ifndef MY_SEARCH_INDEX_H
+#define MY_SEARCH_INDEX_H
+
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_parallel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MY_SEARCH_INDEX_X86 1
+#include <immintrin.h>
+#endif
+
+// Immutable search indexes over sorted keys, laid out for the cache instead of in sorted order.
+// Layouts : https://algorithmica.org/en/eytzinger and https://algorithmica.org/en/s-tree
+//
+// Both answer lower_bound() queries with a position in the original sorted my_vector,
+// so they can sit next to it as a faster replacement of std::lower_bound.
+// Positions are kept as 32 bit ranks, indexes hold less than 2^32 keys.
+
+namespace cpp_training {
+
+namespace detail {
+
+inline void prefetch(const void* p) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+template <typename T>
+void check_index_keys(const my_vector<T>& sorted) {
+    static_assert(std::is_arithmetic<T>::value, "search indexes need arithmetic keys");
+    if (sorted.size() >= UINT32_MAX) throw std::length_error("too many keys for a search index");
+}
+
+// Number of the Count keys less than key, the loop is vectorized by the compiler
+template <size_t Count, typename T>
+size_t count_less(const T* keys, T key) {
+    size_t result = 0;
+    for (size_t i = 0; i < Count; ++i) {
+        result += keys[i] < key;
+    }
+    return result;
+}
+
+#ifdef MY_SEARCH_INDEX_X86
+
+//
+// AVX2 node search, compiled for that target whatever the flags of the translation unit
+//
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace avx2 {
+
+// Number of the 8 keys (32 byte aligned) less than key.
+// Unsigned 64 bit compare through the signed one: flip the sign bits of both sides
+inline size_t count_less8(const uint64_t* keys, uint64_t key) {
+    const __m256i flip = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i x = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(key)), flip);
+    auto lo = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(keys)), flip);
+    auto hi = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(keys + 4)), flip);
+    auto mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, lo)))
+              | _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, hi))) << 4;
+    return static_cast<size_t>(__builtin_popcount(mask));
+}
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif // MY_SEARCH_INDEX_X86
+
+inline bool has_avx2() {
+#ifdef MY_SEARCH_INDEX_X86
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+}
+
+// Sorted keys in Eytzinger (breadth first) order: the children of slot k are 2k and 2k + 1.
+// The top of the tree stays in cache and the descendants of a slot log2(KeysPerLine) levels down share
+// a cache line, so every lookup prefetches them while it compares, and the search loop is branch free.
+template <typename T = uint64_t>
+class my_eytzinger_index {
+    static constexpr size_t KeysPerLine = CacheLineSize / sizeof(T);
+
+    struct alignas(CacheLineSize) line {
+        T keys[KeysPerLine];
+    };
+
+public:
+    using key_type = T;
+
+public:
+
+    my_eytzinger_index() {
+    }
+
+    // sorted must be sorted ascending, duplicates are allowed
+    explicit my_eytzinger_index(const my_vector<T>& sorted) : m_size(sorted.size()) {
+        detail::check_index_keys(sorted);
+        // Slot 0 is unused, slot k sits at the same offset in its line as k in [0, KeysPerLine)
+        m_lines.reserve(m_size / KeysPerLine + 1);
+        m_lines.resize(m_size / KeysPerLine + 1);
+        m_ranks.reserve(m_size + 1);
+        m_ranks.resize(m_size + 1);
+        size_t next = 0;
+        build(sorted, 1, next);
+    }
+
+    size_t size() const { return m_size; }
+
+    bool is_empty() const { return m_size == 0; }
+
+    // Position of the first key not less than key in the original vector, size() if there is none
+    size_t lower_bound(T key) const {
+        auto k = lower_slot(key);
+        return k ? m_ranks[k] : m_size;
+    }
+
+    // Position of key in the original vector, size() if it is absent
+    size_t find(T key) const {
+        auto k = lower_slot(key);
+        return k && slots()[k] == key ? m_ranks[k] : m_size;
+    }
+
+    bool contains(T key) const { return find(key) != m_size; }
+
+    // lower_bound() of every query, computed by several threads
+    my_vector<size_t> lower_bounds(const parallel_policy& policy, const my_vector<T>& queries) const {
+        my_vector<size_t> result;
+        result.reserve(queries.size());
+        result.resize(policy, queries.size());
+        detail::parallel_for(policy, queries.size(), [this, &queries, &result](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) result[i] = lower_bound(queries[i]);
+        });
+        return result;
+    }
+
+private:
+    const T* slots() const {
+        return reinterpret_cast<const T*>(m_lines.data());
+    }
+
+    // Slot of the first key not less than key, 0 if there is none
+    size_t lower_slot(T key) const {
+        const T* keys = slots();
+        size_t k = 1;
+        while (k <= m_size) {
+            detail::prefetch(keys + k * KeysPerLine);
+            k = 2 * k + (keys[k] < key);
+        }
+        // The answer is where the search turned left for the last time: drop the trailing right turns and that turn
+        return k >> __builtin_ffsll(~static_cast<long long>(k));
+    }
+
+    // In order traversal of the implicit tree hands out the sorted keys
+    void build(const my_vector<T>& sorted, size_t k, size_t& next) {
+        if (k <= m_size) {
+            build(sorted, 2 * k, next);
+            reinterpret_cast<T*>(m_lines.data())[k] = sorted[next];
+            m_ranks[k] = static_cast<uint32_t>(next++);
+            build(sorted, 2 * k + 1, next);
+        }
+    }
+
+private:
+    my_vector<line> m_lines;
+    my_vector<uint32_t> m_ranks;
+    size_t m_size = 0;
+};
+
+// Sorted keys in a static B-tree (S-tree): every node is one cache line of B keys and has B + 1 implicit children,
+// node k's children are k * (B + 1) + i + 1. A lookup touches log_(B+1)(n) cache lines and compares a whole node
+// at once, with AVX2 for 64 bit keys when the CPU has it.
+// Missing keys of the last nodes are padded with the maximum key.
+template <typename T = uint64_t>
+class my_stree_index {
+public:
+    using key_type = T;
+
+    // Keys per node
+    static constexpr size_t B = CacheLineSize / sizeof(T);
+
+private:
+    struct alignas(CacheLineSize) node {
+        T keys[B];
+    };
+
+public:
+
+    my_stree_index() {
+    }
+
+    // sorted must be sorted ascending, duplicates are allowed
+    explicit my_stree_index(const my_vector<T>& sorted) : m_size(sorted.size()) {
+        detail::check_index_keys(sorted);
+        m_node_count = (m_size + B - 1) / B;
+        m_nodes.reserve(m_node_count);
+        m_nodes.resize(m_node_count);
+        m_ranks.reserve(m_node_count * B);
+        m_ranks.resize(m_node_count * B);
+        size_t next = 0;
+        build(sorted, 0, next);
+    }
+
+    size_t size() const { return m_size; }
+
+    bool is_empty() const { return m_size == 0; }
+
+    // Position of the first key not less than key in the original vector, size() if there is none
+    size_t lower_bound(T key) const {
+        auto slot = lower_slot(key);
+        return slot != NoSlot ? m_ranks[slot] : m_size;
+    }
+
+    // Position of key in the original vector, size() if it is absent
+    size_t find(T key) const {
+        auto slot = lower_slot(key);
+        return slot != NoSlot && m_nodes[slot / B].keys[slot % B] == key ? m_ranks[slot] : m_size;
+    }
+
+    bool contains(T key) const { return find(key) != m_size; }
+
+    // lower_bound() of every query, computed by several threads
+    my_vector<size_t> lower_bounds(const parallel_policy& policy, const my_vector<T>& queries) const {
+        my_vector<size_t> result;
+        result.reserve(queries.size());
+        result.resize(policy, queries.size());
+        detail::parallel_for(policy, queries.size(), [this, &queries, &result](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) result[i] = lower_bound(queries[i]);
+        });
+        return result;
+    }
+
+private:
+    static constexpr size_t NoSlot = SIZE_MAX;
+
+    static size_t child(size_t k, size_t i) {
+        return k * (B + 1) + i + 1;
+    }
+
+    // Slot (node * B + index in the node) of the first key not less than key, NoSlot if there is none
+    size_t lower_slot(T key) const {
+#ifdef MY_SEARCH_INDEX_X86
+        if (std::is_same<T, uint64_t>::value && B == 8 && detail::has_avx2()) {
+            return lower_slot(key, [](const T* keys, T k) {
+                return detail::avx2::count_less8(reinterpret_cast<const uint64_t*>(keys), static_cast<uint64_t>(k));
+            });
+        }
+#endif
+        return lower_slot(key, [](const T* keys, T k) { return detail::count_less<B>(keys, k); });
+    }
+
+    template <typename CountLess>
+    size_t lower_slot(T key, CountLess count_less) const {
+        size_t k = 0, result = NoSlot;
+        while (k < m_node_count) {
+            auto i = count_less(m_nodes[k].keys, key);
+            if (i < B) result = k * B + i;
+            k = child(k, i);
+        }
+        return result;
+    }
+
+    // In order traversal of the implicit tree hands out the sorted keys, padding goes last
+    void build(const my_vector<T>& sorted, size_t k, size_t& next) {
+        if (k < m_node_count) {
+            for (size_t i = 0; i < B; ++i) {
+                build(sorted, child(k, i), next);
+                if (next < m_size) {
+                    m_nodes[k].keys[i] = sorted[next];
+                    m_ranks[k * B + i] = static_cast<uint32_t>(next++);
+                } else {
+                    m_nodes[k].keys[i] = std::numeric_limits<T>::max();
+                    m_ranks[k * B + i] = static_cast<uint32_t>(m_size);
+                }
+            }
+            build(sorted, child(k, B), next);
+        }
+    }
+
+private:
+    my_vector<node> m_nodes;
+    my_vector<uint32_t> m_ranks;
+    size_t m_size = 0;
+    size_t m_node_count = 0;
+};
+
+}
+
+#endif // MY_SEARCH_INDEX_H
@@ -0,0 +1,62 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// Mean lower_bound latency of std::lower_bound over a sorted my_vector vs my_eytzinger_index and my_stree_index,
+// for key counts from cache resident to far beyond the last level cache. Usage: MyVector_SEARCH_BENCH [max keys]
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include "my_search_index.h"
+
+using namespace cpp_training;
+
+namespace {
+
+constexpr size_t Queries = 4000000;
+
+template <typename Search>
+double ns_per_query(const my_vector<uint64_t>& queries, Search search) {
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto key : queries) {
+        checksum += search(key);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    // Keeps the searches from being optimized away
+    if (checksum == 42) std::cout << ' ';
+    return elapsed / queries.size();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_keys = argc > 1 ? std::stoull(argv[1]) : 100000000;
+    std::mt19937_64 gen(1);
+
+    my_vector<uint64_t> queries;
+    queries.reserve(Queries);
+    for (size_t i = 0; i < Queries; ++i) queries.push_back(gen());
+
+    std::cout << std::setw(12) << "keys" << std::setw(16) << "lower_bound ns"
+              << std::setw(16) << "eytzinger ns" << std::setw(16) << "s-tree ns" << std::endl;
+    for (size_t count = 1000; count <= max_keys; count *= 10) {
+        my_vector<uint64_t> keys;
+        keys.reserve(count);
+        for (size_t i = 0; i < count; ++i) keys.push_back(gen());
+        std::sort(keys.data(), keys.data() + keys.size());
+        my_eytzinger_index<> eytzinger(keys);
+        my_stree_index<> stree(keys);
+
+        auto std_ns = ns_per_query(queries, [&keys](uint64_t key) {
+            return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        });
+        auto eytzinger_ns = ns_per_query(queries, [&eytzinger](uint64_t key) { return eytzinger.lower_bound(key); });
+        auto stree_ns = ns_per_query(queries, [&stree](uint64_t key) { return stree.lower_bound(key); });
+        std::cout << std::setw(12) << count << std::fixed << std::setprecision(1)
+                  << std::setw(16) << std_ns << std::setw(16) << eytzinger_ns << std::setw(16) << stree_ns << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_search_index.h"
+#include <algorithm>
+#include <random>
+
+using namespace cpp_training;
+
+namespace {
+
+template <typename T>
+my_vector<T> sorted_keys(size_t count, T max_key, unsigned seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<T> dist(0, max_key);
+    my_vector<T> keys;
+    for (size_t i = 0; i < count; ++i) keys.push_back(dist(gen));
+    std::sort(keys.data(), keys.data() + keys.size());
+    return keys;
+}
+
+// Compares an index against std::lower_bound on every key in [0, max_key + 1] and at the extremes
+template <typename Index, typename T>
+void check_index(const my_vector<T>& keys, T max_key) {
+    Index index(keys);
+    ASSERT_EQ(index.size(), keys.size());
+    auto first = keys.data(), last = keys.data() + keys.size();
+    for (T key = 0; key <= max_key + 1; ++key) {
+        auto expected = static_cast<size_t>(std::lower_bound(first, last, key) - first);
+        ASSERT_EQ(index.lower_bound(key), expected) << "size " << keys.size() << " key " << key;
+        auto found = expected != keys.size() && keys[expected] == key ? expected : keys.size();
+        ASSERT_EQ(index.find(key), found);
+    }
+    EXPECT_EQ(index.lower_bound(std::numeric_limits<T>::max()),
+              keys.size() && keys.back() == std::numeric_limits<T>::max() ? keys.size() - 1 : keys.size());
+}
+
+}
+
+TEST(MySearchIndexTest, EytzingerMatchesLowerBound) {
+    for (size_t n = 0; n < 300; n += (n < 40 ? 1 : 37)) {
+        check_index<my_eytzinger_index<uint64_t>>(sorted_keys<uint64_t>(n, 3 * n, n), 3 * n);
+        check_index<my_eytzinger_index<uint32_t>>(sorted_keys<uint32_t>(n, n / 2, n), static_cast<uint32_t>(n / 2));
+    }
+}
+
+TEST(MySearchIndexTest, STreeMatchesLowerBound) {
+    for (size_t n = 0; n < 3000; n += (n < 40 ? 1 : 173)) {
+        check_index<my_stree_index<uint64_t>>(sorted_keys<uint64_t>(n, 3 * n, n), 3 * n);
+        check_index<my_stree_index<uint32_t>>(sorted_keys<uint32_t>(n, n / 2, n), static_cast<uint32_t>(n / 2));
+    }
+}
+
+TEST(MySearchIndexTest, Extremes) {
+    my_vector<uint64_t> keys {0, 0, 5, UINT64_MAX, UINT64_MAX};
+    my_eytzinger_index<> eytzinger(keys);
+    my_stree_index<> stree(keys);
+    EXPECT_EQ(eytzinger.lower_bound(0), 0);
+    EXPECT_EQ(stree.lower_bound(0), 0);
+    EXPECT_EQ(eytzinger.lower_bound(UINT64_MAX), 3);
+    EXPECT_EQ(stree.lower_bound(UINT64_MAX), 3);
+    EXPECT_TRUE(stree.contains(UINT64_MAX));
+    EXPECT_FALSE(eytzinger.contains(4));
+
+    my_eytzinger_index<> empty;
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_EQ(empty.lower_bound(1), 0);
+}
+
+TEST(MySearchIndexTest, NodeSearchKernels) {
+    // The indexes above use the AVX2 kernel when the CPU has it, this checks it against the portable one directly
+    if (!detail::has_avx2()) return;
+#ifdef MY_SEARCH_INDEX_X86
+    std::mt19937_64 gen(7);
+    alignas(32) uint64_t keys[8];
+    for (int round = 0; round < 1000; ++round) {
+        // Small keys collide, large ones reach the sign bit the signed compare has to flip
+        auto max_key = round % 2 ? UINT64_MAX : uint64_t{16};
+        std::uniform_int_distribution<uint64_t> dist(0, max_key);
+        for (auto& k : keys) k = dist(gen);
+        std::sort(keys, keys + 8);
+        for (uint64_t key : {uint64_t{0}, keys[0], keys[3], keys[7], dist(gen), dist(gen), UINT64_MAX}) {
+            ASSERT_EQ(detail::avx2::count_less8(keys, key), detail::count_less<8>(keys, key)) << key;
+        }
+    }
+#endif
+}
+
+TEST(MySearchIndexTest, BatchLookups) {
+    auto keys = sorted_keys<uint64_t>(100000, 1000000, 1);
+    auto queries = sorted_keys<uint64_t>(200000, 1100000, 2);
+    std::shuffle(queries.data(), queries.data() + queries.size(), std::mt19937(3));
+    my_eytzinger_index<> eytzinger(keys);
+    my_stree_index<> stree(keys);
+    auto by_eytzinger = eytzinger.lower_bounds(parallel_policy{4}, queries);
+    auto by_stree = stree.lower_bounds(parallel_policy{4}, queries);
+    ASSERT_EQ(by_eytzinger.size(), queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto expected = std::lower_bound(keys.data(), keys.data() + keys.size(), queries[i]) - keys.data();
+        ASSERT_EQ(by_eytzinger[i], expected);
+        ASSERT_EQ(by_stree[i], expected);
+    }
+}
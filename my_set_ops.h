@@ -0,0 +1,402 @@
+#ifndef MY_SET_OPS_H
+#define MY_SET_OPS_H
+
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_radix_sort.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MY_SET_OPS_X86 1
+#include <immintrin.h>
+#endif
+
+// Interface after https://en.cppreference.com/w/cpp/algorithm#Set_operations_.28on_sorted_ranges.29
+//
+// Set operations over sorted my_vectors without duplicates, such as posting lists. The kernels write the result
+// through a raw pointer, without a capacity check per element, into the output's storage, which is grown for the
+// largest possible result up front by my_vector::resize_and_overwrite. So a reused output needs no allocation,
+// and for numbers its storage isn't initialized before the kernel writes it.
+// The output must not be one of the inputs, std::invalid_argument otherwise.
+
+namespace cpp_training {
+
+namespace detail {
+
+// With one input this many times longer than the other, the shorter one's elements are looked up in it
+// by galloping instead of walking both
+constexpr size_t GallopRatio = 32;
+
+// First element of sorted [first, last) not less than value, by steps doubling from first and a binary search.
+// O(log d) for a result d elements away, so walking a long range by galloping costs O(n log(m / n))
+template <typename T, typename Compare>
+const T* gallop(const T* first, const T* last, const T& value, Compare& comp) {
+    if (first == last || !comp(*first, value)) return first;
+    size_t step = 1;
+    while (step < static_cast<size_t>(last - first) && comp(first[step], value)) {
+        first += step;
+        step *= 2;
+    }
+    return std::lower_bound(first + 1, first + std::min(step, static_cast<size_t>(last - first)), value, comp);
+}
+
+template <typename T>
+void check_output(const my_vector<T>& out, const my_vector<T>& a, const my_vector<T>& b) {
+    if (&out == &a || &out == &b) throw std::invalid_argument("the output is one of the inputs");
+}
+
+// Total size of the lists, which out must not be one of
+template <typename T>
+size_t total_size(const my_vector<my_vector<T>>& lists, const my_vector<T>& out) {
+    size_t total = 0;
+    for (auto& list : lists) {
+        if (&list == &out) throw std::invalid_argument("the output is one of the inputs");
+        total += list.size();
+    }
+    return total;
+}
+
+// Whether intersections can take the vector kernel
+template <typename T, typename Compare>
+struct simd_intersectable : std::integral_constant<bool,
+    (std::is_same<T, uint32_t>::value || std::is_same<T, int32_t>::value) &&
+    (std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::less<>>::value)> {};
+
+// The kernels return the number of elements written to out
+
+// Walks both inputs without a branch on the data, the element of a is written whether it matches or not
+template <typename T, typename Compare>
+size_t intersect_merge(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < n && j < m) {
+        const T& x = a[i];
+        const T& y = b[j];
+        bool less = comp(x, y), greater = comp(y, x);
+        out[k] = x;
+        k += !less && !greater;
+        i += !greater;
+        j += !less;
+    }
+    return k;
+}
+
+// Looks up the elements of the short a in the long b
+template <typename T, typename Compare>
+size_t intersect_gallop(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    size_t k = 0;
+    const T* p = b;
+    const T* last = b + m;
+    for (size_t i = 0; i < n && p != last; ++i) {
+        p = gallop(p, last, a[i], comp);
+        if (p != last && !comp(a[i], *p)) {
+            out[k++] = a[i];
+            ++p;
+        }
+    }
+    return k;
+}
+
+#ifdef MY_SET_OPS_X86
+// pshufb masks moving the lanes set in a 4 bit mask to the front
+struct compact_table {
+    alignas(16) uint8_t bytes[16][16];
+
+    constexpr compact_table() : bytes() {
+        for (unsigned mask = 0; mask < 16; ++mask) {
+            unsigned out = 0;
+            for (unsigned lane = 0; lane < 4; ++lane) {
+                if (!(mask & (1u << lane))) continue;
+                for (unsigned byte = 0; byte < 4; ++byte) bytes[mask][out * 4 + byte] = static_cast<uint8_t>(lane * 4 + byte);
+                ++out;
+            }
+            for (unsigned byte = out * 4; byte < 16; ++byte) bytes[mask][byte] = 0x80;
+        }
+    }
+};
+
+inline constexpr compact_table CompactTable {};
+
+//
+// SSSE3 kernel, compiled for that target whatever the flags of the translation unit
+//
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("ssse3"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("ssse3")
+#endif
+
+namespace ssse3 {
+
+// Schlegel, Willhalm and Lehner's block intersection: 4 elements of a are compared with 4 of b in all 16 pairings
+// through 3 rotations of b, the matches are packed to the front by one shuffle and stored as a whole register,
+// and the block with the smaller last element is replaced. Tails are merged by the scalar kernel
+template <typename T>
+size_t intersect_simd(const T* a, size_t n, const T* b, size_t m, T* out) {
+    const size_t bound = std::min(n, m);
+    size_t i = 0, j = 0, k = 0;
+    while (i + 4 <= n && j + 4 <= m) {
+        auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        auto eq = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        auto mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        auto shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(CompactTable.bytes[mask]));
+        auto packed = _mm_shuffle_epi8(va, shuffle);
+        auto count = static_cast<size_t>(__builtin_popcount(mask));
+        if (k + 4 <= bound) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), packed);
+        } else {
+            // The whole register would reach past the bound near the end of the output, only the matches fit
+            alignas(16) T lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), packed);
+            std::copy(lanes, lanes + count, out + k);
+        }
+        k += count;
+        T a_last = a[i + 3], b_last = b[j + 3];
+        i += a_last <= b_last ? 4 : 0;
+        j += b_last <= a_last ? 4 : 0;
+    }
+    std::less<T> comp;
+    return k + intersect_merge(a + i, n - i, b + j, m - j, out + k, comp);
+}
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif // MY_SET_OPS_X86
+
+inline bool has_ssse3() {
+#ifdef MY_SET_OPS_X86
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3") != 0);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+template <typename T, typename Compare>
+size_t intersect(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    if (n > m) return intersect(b, m, a, n, out, comp);
+    if (n == 0) return 0;
+    if (m / n >= GallopRatio) return intersect_gallop(a, n, b, m, out, comp);
+#ifdef MY_SET_OPS_X86
+    if constexpr (simd_intersectable<T, Compare>::value) {
+        if (has_ssse3()) return ssse3::intersect_simd(a, n, b, m, out);
+    }
+#endif
+    return intersect_merge(a, n, b, m, out, comp);
+}
+
+// Copies the runs of the long b between the elements of the short a, found by galloping
+template <typename T, typename Compare>
+size_t union_gallop(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    size_t k = 0;
+    const T* p = b;
+    const T* last = b + m;
+    for (size_t i = 0; i < n; ++i) {
+        auto q = gallop(p, last, a[i], comp);
+        out = std::copy(p, q, out);
+        k += q - p;
+        *out++ = a[i];
+        ++k;
+        p = q != last && !comp(a[i], *q) ? q + 1 : q;
+    }
+    std::copy(p, last, out);
+    return k + (last - p);
+}
+
+template <typename T, typename Compare>
+size_t union_merge(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < n && j < m) {
+        const T& x = a[i];
+        const T& y = b[j];
+        bool take_b = comp(y, x);
+        out[k++] = take_b ? y : x;
+        i += !take_b;
+        j += !comp(x, y);
+    }
+    std::copy(a + i, a + n, out + k);
+    std::copy(b + j, b + m, out + k + (n - i));
+    return k + (n - i) + (m - j);
+}
+
+template <typename T, typename Compare>
+size_t difference_merge(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < n && j < m) {
+        const T& x = a[i];
+        const T& y = b[j];
+        bool less = comp(x, y), greater = comp(y, x);
+        out[k] = x;
+        k += less;
+        i += !greater;
+        j += !less;
+    }
+    std::copy(a + i, a + n, out + k);
+    return k + (n - i);
+}
+
+// The short a against the long b: every element of a is looked up in b
+template <typename T, typename Compare>
+size_t difference_gallop_b(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    size_t k = 0;
+    const T* p = b;
+    const T* last = b + m;
+    for (size_t i = 0; i < n; ++i) {
+        p = gallop(p, last, a[i], comp);
+        if (p == last || comp(a[i], *p)) out[k++] = a[i];
+    }
+    return k;
+}
+
+// The long a against the short b: the runs of a between the elements of b are copied whole
+template <typename T, typename Compare>
+size_t difference_gallop_a(const T* a, size_t n, const T* b, size_t m, T* out, Compare& comp) {
+    size_t k = 0;
+    const T* p = a;
+    const T* last = a + n;
+    for (size_t j = 0; j < m && p != last; ++j) {
+        auto q = gallop(p, last, b[j], comp);
+        std::copy(p, q, out + k);
+        k += q - p;
+        p = q != last && !comp(b[j], *q) ? q + 1 : q;
+    }
+    std::copy(p, last, out + k);
+    return k + (last - p);
+}
+
+// k-way merge through a binary heap of the heads of the lists; on equal heads the earlier list goes first,
+// so the merge is stable. Unique drops elements equal to the last one written
+template <bool Unique, typename T, typename Compare>
+size_t merge_lists(const my_vector<my_vector<T>>& lists, T* out, Compare& comp) {
+    struct cursor {
+        const T* p;
+        const T* last;
+        size_t list;
+    };
+    auto before = [&comp](const cursor& x, const cursor& y) {
+        return comp(*x.p, *y.p) || (!comp(*y.p, *x.p) && x.list < y.list);
+    };
+    my_vector<cursor> heap;
+    heap.reserve(lists.size());
+    for (size_t l = 0; l < lists.size(); ++l) {
+        if (!lists[l].is_empty()) heap.push_back(cursor{lists[l].data(), lists[l].data() + lists[l].size(), l});
+    }
+    auto sift_down = [&heap, &before](size_t i) {
+        const size_t count = heap.size();
+        auto moved = heap[i];
+        for (size_t child = 2 * i + 1; child < count; child = 2 * i + 1) {
+            if (child + 1 < count && before(heap[child + 1], heap[child])) ++child;
+            if (!before(heap[child], moved)) break;
+            heap[i] = heap[child];
+            i = child;
+        }
+        heap[i] = moved;
+    };
+    for (size_t i = heap.size() / 2; i-- > 0;) sift_down(i);
+
+    size_t k = 0;
+    while (heap.size() > 1) {
+        // The top is replaced in place, one sift per element instead of a pop and a push
+        auto& top = heap[0];
+        if (!Unique || k == 0 || comp(out[k - 1], *top.p)) out[k++] = *top.p;
+        if (++top.p == top.last) {
+            top = heap.back();
+            heap.pop_back();
+        }
+        sift_down(0);
+    }
+    if (!heap.is_empty()) {
+        for (auto p = heap[0].p; p != heap[0].last; ++p) {
+            if (!Unique || k == 0 || comp(out[k - 1], *p)) out[k++] = *p;
+        }
+    }
+    return k;
+}
+
+}
+
+// Sorts v and removes the duplicates. Numbers in their natural order are sorted by radix_sort
+template <typename T, typename Compare = std::less<T>>
+void sort_unique(my_vector<T>& v, Compare comp = Compare()) {
+    if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && std::is_same<Compare, std::less<T>>::value) {
+        radix_sort(v);
+    } else {
+        std::sort(v.data(), v.data() + v.size(), comp);
+    }
+    size_t k = 0;
+    T* data = v.data();
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (k == 0 || comp(data[k - 1], data[i])) {
+            if (k != i) data[k] = std::move(data[i]);
+            ++k;
+        }
+    }
+    v.resize(k);
+}
+
+// out = a | b
+template <typename T, typename Compare = std::less<T>>
+void set_union(const my_vector<T>& a, const my_vector<T>& b, my_vector<T>& out, Compare comp = Compare()) {
+    detail::check_output(out, a, b);
+    auto n = a.size(), m = b.size();
+    out.resize_and_overwrite(n + m, [&](T* p, size_t) {
+        if (n && m / n >= detail::GallopRatio) return detail::union_gallop(a.data(), n, b.data(), m, p, comp);
+        if (m && n / m >= detail::GallopRatio) return detail::union_gallop(b.data(), m, a.data(), n, p, comp);
+        return detail::union_merge(a.data(), n, b.data(), m, p, comp);
+    });
+}
+
+// out = a & b. Gallops through the longer input when the sizes are far apart,
+// otherwise compares blocks of 4 in SSE registers for 32 bit integers when the CPU has SSSE3
+template <typename T, typename Compare = std::less<T>>
+void set_intersection(const my_vector<T>& a, const my_vector<T>& b, my_vector<T>& out, Compare comp = Compare()) {
+    detail::check_output(out, a, b);
+    out.resize_and_overwrite(std::min(a.size(), b.size()), [&](T* p, size_t) {
+        return detail::intersect(a.data(), a.size(), b.data(), b.size(), p, comp);
+    });
+}
+
+// out = a - b
+template <typename T, typename Compare = std::less<T>>
+void set_difference(const my_vector<T>& a, const my_vector<T>& b, my_vector<T>& out, Compare comp = Compare()) {
+    detail::check_output(out, a, b);
+    auto n = a.size(), m = b.size();
+    out.resize_and_overwrite(n, [&](T* p, size_t) {
+        if (n && m / n >= detail::GallopRatio) return detail::difference_gallop_b(a.data(), n, b.data(), m, p, comp);
+        if (m && n / m >= detail::GallopRatio) return detail::difference_gallop_a(a.data(), n, b.data(), m, p, comp);
+        return detail::difference_merge(a.data(), n, b.data(), m, p, comp);
+    });
+}
+
+// Stable merge of the sorted lists into out, duplicates included
+template <typename T, typename Compare = std::less<T>>
+void merge(const my_vector<my_vector<T>>& lists, my_vector<T>& out, Compare comp = Compare()) {
+    out.resize_and_overwrite(detail::total_size(lists, out), [&](T* p, size_t) {
+        return detail::merge_lists<false>(lists, p, comp);
+    });
+}
+
+// Union of the sorted lists into out, each element once
+template <typename T, typename Compare = std::less<T>>
+void merge_unique(const my_vector<my_vector<T>>& lists, my_vector<T>& out, Compare comp = Compare()) {
+    out.resize_and_overwrite(detail::total_size(lists, out), [&](T* p, size_t) {
+        return detail::merge_lists<true>(lists, p, comp);
+    });
+}
+
+}
+
+#endif // MY_SET_OPS_H
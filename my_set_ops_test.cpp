@@ -0,0 +1,150 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_set_ops.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+
+using namespace cpp_training;
+
+namespace {
+
+// count sorted distinct values from [0, range)
+my_vector<uint32_t> random_set(size_t count, uint32_t range, std::mt19937& gen) {
+    my_vector<uint32_t> result;
+    for (size_t i = 0; i < count; ++i) result.push_back(gen() % range);
+    std::sort(result.begin(), result.end());
+    result.resize(std::unique(result.begin(), result.end()) - result.begin());
+    return result;
+}
+
+template <typename T, typename StdOp>
+my_vector<T> expected_of(const my_vector<T>& a, const my_vector<T>& b, StdOp op) {
+    std::vector<T> result;
+    op(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    my_vector<T> copy;
+    for (auto& x : result) copy.push_back(x);
+    return copy;
+}
+
+}
+
+TEST(MySetOpsTest, AgainstStd) {
+    std::mt19937 gen(1);
+    // Similar sizes take the merge (or SSE) kernels, far apart ones the galloping ones
+    const size_t sizes[][2] = {{0, 0}, {0, 10}, {1, 1}, {3, 5}, {100, 100}, {1000, 900}, {10, 5000}, {5000, 3}, {1, 100000}};
+    for (auto& size : sizes) {
+        for (uint32_t range : {50u, 10000u, 1000000u}) {
+            auto a = random_set(size[0], range, gen);
+            auto b = random_set(size[1], range, gen);
+            my_vector<uint32_t> out;
+            set_union(a, b, out);
+            ASSERT_EQ(out, expected_of(a, b, [](auto... args) { return std::set_union(args...); })) << size[0] << " " << size[1];
+            set_intersection(a, b, out);
+            ASSERT_EQ(out, expected_of(a, b, [](auto... args) { return std::set_intersection(args...); })) << size[0] << " " << size[1];
+            set_difference(a, b, out);
+            ASSERT_EQ(out, expected_of(a, b, [](auto... args) { return std::set_difference(args...); })) << size[0] << " " << size[1];
+            set_difference(b, a, out);
+            ASSERT_EQ(out, expected_of(b, a, [](auto... args) { return std::set_difference(args...); })) << size[0] << " " << size[1];
+        }
+    }
+}
+
+TEST(MySetOpsTest, Kernels) {
+    // Each intersection kernel directly, whatever the dispatch would pick, into exactly min(n, m) elements
+    auto check = [](const my_vector<uint32_t>& a, const my_vector<uint32_t>& b) {
+        auto expected = expected_of(a, b, [](auto... args) { return std::set_intersection(args...); });
+        my_vector<uint32_t> out(std::min(a.size(), b.size()), 0u);
+        std::less<uint32_t> comp;
+        auto k = detail::intersect_merge(a.data(), a.size(), b.data(), b.size(), out.data(), comp);
+        ASSERT_TRUE(std::equal(out.data(), out.data() + k, expected.begin(), expected.end()));
+        k = detail::intersect_gallop(a.data(), a.size(), b.data(), b.size(), out.data(), comp);
+        ASSERT_TRUE(std::equal(out.data(), out.data() + k, expected.begin(), expected.end()));
+#ifdef MY_SET_OPS_X86
+        if (detail::has_ssse3()) {
+            k = detail::ssse3::intersect_simd(a.data(), a.size(), b.data(), b.size(), out.data());
+            ASSERT_TRUE(std::equal(out.data(), out.data() + k, expected.begin(), expected.end()));
+        }
+#endif
+    };
+    std::mt19937 gen(2);
+    for (int round = 0; round < 200; ++round) {
+        check(random_set(gen() % 300, 1000, gen), random_set(gen() % 300, 1000, gen));
+    }
+    // Matches in the first block of a while b's blocks advance: the output is full before a is
+    my_vector<uint32_t> b;
+    for (uint32_t x = 1; x <= 40; ++x) b.push_back(x);
+    check(my_vector<uint32_t>{1, 2, 3, 100}, b);
+    check(b, my_vector<uint32_t>{1, 2, 3, 100});
+    check(my_vector<uint32_t>{1, 2, 3, 4}, my_vector<uint32_t>{1, 2, 3, 4});
+}
+
+TEST(MySetOpsTest, OutputReuse) {
+    my_vector<int32_t> a {-5, -1, 0, 3, 8};
+    my_vector<int32_t> b {-1, 3, 4};
+    my_vector<int32_t> out(100, 7);
+    set_intersection(a, b, out);
+    EXPECT_EQ(out, (my_vector<int32_t>{-1, 3}));
+    set_union(a, b, out);
+    EXPECT_EQ(out, (my_vector<int32_t>{-5, -1, 0, 3, 4, 8}));
+    EXPECT_THROW(set_union(a, b, a), std::invalid_argument);
+    EXPECT_THROW(set_intersection(a, b, b), std::invalid_argument);
+}
+
+TEST(MySetOpsTest, CustomOrder) {
+    my_vector<std::string> a {"pear", "kiwi", "fig", "apple"};
+    my_vector<std::string> b {"plum", "kiwi", "banana"};
+    my_vector<std::string> out;
+    set_union(a, b, out, std::greater<std::string>());
+    EXPECT_EQ(out, (my_vector<std::string>{"plum", "pear", "kiwi", "fig", "banana", "apple"}));
+    set_intersection(a, b, out, std::greater<std::string>());
+    EXPECT_EQ(out, (my_vector<std::string>{"kiwi"}));
+    set_difference(a, b, out, std::greater<std::string>());
+    EXPECT_EQ(out, (my_vector<std::string>{"pear", "fig", "apple"}));
+}
+
+TEST(MySetOpsTest, SortUnique) {
+    std::mt19937 gen(3);
+    for (size_t n : {0, 1, 50, 1000, 100000}) {
+        my_vector<uint64_t> v;
+        for (size_t i = 0; i < n; ++i) v.push_back(gen() % (n / 2 + 1));
+        std::vector<uint64_t> expected(v.begin(), v.end());
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        sort_unique(v);
+        ASSERT_TRUE(std::equal(v.begin(), v.end(), expected.begin(), expected.end())) << n;
+    }
+    my_vector<std::string> words {"b", "a", "c", "a", "b"};
+    sort_unique(words, std::greater<std::string>());
+    EXPECT_EQ(words, (my_vector<std::string>{"c", "b", "a"}));
+}
+
+TEST(MySetOpsTest, KWayMerge) {
+    std::mt19937 gen(4);
+    for (size_t k : {0, 1, 2, 3, 16}) {
+        my_vector<my_vector<uint32_t>> lists;
+        my_vector<uint32_t> all;
+        for (size_t l = 0; l < k; ++l) {
+            lists.push_back(random_set(gen() % 500, 2000, gen));
+            for (auto x : lists.back()) all.push_back(x);
+        }
+        std::sort(all.begin(), all.end());
+        my_vector<uint32_t> out;
+        merge(lists, out);
+        ASSERT_EQ(out, all) << k;
+        merge_unique(lists, out);
+        all.resize(std::unique(all.begin(), all.end()) - all.begin());
+        ASSERT_EQ(out, all) << k;
+    }
+
+    // Equal keys come out list by list
+    using entry = std::pair<int, int>;
+    my_vector<my_vector<entry>> lists {{{1, 0}, {3, 0}}, {{1, 1}, {2, 1}, {3, 1}}, {{1, 2}}};
+    my_vector<entry> out;
+    merge(lists, out, [](const entry& x, const entry& y) { return x.first < y.first; });
+    EXPECT_EQ(out, (my_vector<entry>{{1, 0}, {1, 1}, {1, 2}, {2, 1}, {3, 0}, {3, 1}}));
+    EXPECT_THROW(merge(lists, lists[1]), std::invalid_argument);
+}
@@ -0,0 +1,212 @@
+#ifndef MY_SHARDED_VECTOR_H
+#define MY_SHARDED_VECTOR_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include "my_vector.h"
+#include "my_parallel.h"
+
+namespace cpp_training {
+
+// Append-only vector for many writer threads.
+// Every thread appends into its own my_vector shard, shards are cache line aligned, so pushes
+// need neither locks nor atomics. The shard of the calling thread is found through a thread local cache,
+// only the first push of a thread (or a thread switching between several sharded vectors) takes a mutex.
+//
+// collect(), for_each(), merge_sorted(), size() and clear() read all shards,
+// they must not run concurrently with pushes.
+template <typename T>
+class my_sharded_vector {
+    struct alignas(CacheLineSize) shard {
+        explicit shard(std::thread::id id) : owner(id) {}
+
+        my_vector<T> items;
+        std::thread::id owner;
+    };
+
+public:
+    using value_type = T;
+
+public:
+
+    my_sharded_vector() : m_id(next_id()) {
+    }
+
+    my_sharded_vector(const my_sharded_vector&) = delete;
+    my_sharded_vector& operator = (const my_sharded_vector&) = delete;
+
+    ~my_sharded_vector() noexcept {
+        for (auto shard_p : m_shards) {
+            delete shard_p;
+        }
+    }
+
+    // The shard of the calling thread
+    my_vector<T>& local() {
+        return local_shard().items;
+    }
+
+    void push_back(const T& value) {
+        local_shard().items.push_back(value);
+    }
+
+    void push_back(T&& value) {
+        local_shard().items.push_back(std::move(value));
+    }
+
+    template< class... Args >
+    void emplace_back( Args&&... args ) {
+        local_shard().items.emplace_back(std::forward<Args>(args)...);
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (auto shard_p : m_shards) {
+            total += shard_p->items.size();
+        }
+        return total;
+    }
+
+    size_t shard_count() const {
+        return m_shards.size();
+    }
+
+    // Empties all shards, the shards themselves stay assigned to their threads
+    void clear() {
+        for (auto shard_p : m_shards) {
+            shard_p->items.clear();
+        }
+    }
+
+    // All elements in one my_vector, shard after shard. The result is allocated once and filled in parallel.
+    // T must be default constructible.
+    my_vector<T> collect(const parallel_policy& policy = par) const {
+        my_vector<T> result;
+        gather(policy, result);
+        return result;
+    }
+
+    // Calls fn(const T&) for every element, shards are processed in parallel, so fn must be thread safe
+    template <typename Fn>
+    void for_each(Fn&& fn, const parallel_policy& policy = par) const {
+        detail::parallel_for(policy, m_shards.size(), [this, &fn](size_t first, size_t last) {
+            for (size_t s = first; s < last; ++s) {
+                for (auto& item : m_shards[s]->items) fn(item);
+            }
+        }, 1);
+    }
+
+    // All elements sorted by comp: shards are sorted in place in parallel, then merged pairwise in parallel rounds.
+    // Needs one scratch buffer besides the result.
+    template <typename Compare = std::less<T>>
+    my_vector<T> merge_sorted(Compare comp = Compare(), const parallel_policy& policy = par) {
+        detail::parallel_for(policy, m_shards.size(), [this, &comp](size_t first, size_t last) {
+            for (size_t s = first; s < last; ++s) {
+                auto& items = m_shards[s]->items;
+                std::sort(items.data(), items.data() + items.size(), comp);
+            }
+        }, 1);
+
+        my_vector<T> result;
+        auto runs = gather(policy, result);
+        if (runs.size() <= 2) return result;
+
+        my_vector<T> scratch(result.size());
+        auto src_p = &result, dst_p = &scratch;
+        while (runs.size() > 2) {
+            // runs holds boundaries, run k is [runs[k], runs[k + 1])
+            auto run_count = runs.size() - 1;
+            auto pairs = (run_count + 1) / 2;
+            detail::parallel_for(policy, pairs, [&](size_t first, size_t last) {
+                for (size_t p = first; p < last; ++p) {
+                    auto from = src_p->data() + runs[2 * p];
+                    auto mid = src_p->data() + runs[std::min(2 * p + 1, run_count)];
+                    auto to = src_p->data() + runs[std::min(2 * p + 2, run_count)];
+                    std::merge(std::make_move_iterator(from), std::make_move_iterator(mid),
+                               std::make_move_iterator(mid), std::make_move_iterator(to),
+                               dst_p->data() + runs[2 * p], comp);
+                }
+            }, 1);
+            my_vector<size_t> merged;
+            for (size_t k = 0; k < runs.size(); k += 2) {
+                merged.push_back(runs[k]);
+            }
+            if (merged.back() != runs.back()) merged.push_back(runs.back());
+            runs.swap(merged);
+            std::swap(src_p, dst_p);
+        }
+        if (src_p != &result) result.swap(scratch);
+        return result;
+    }
+
+private:
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> counter {0};
+        return ++counter;
+    }
+
+    shard& local_shard() {
+        // Instance ids are never reused, so a stale entry can't match a new sharded vector
+        thread_local uint64_t cached_id = 0;
+        thread_local shard* cached_shard_p = nullptr;
+        if (cached_id != m_id) {
+            cached_shard_p = find_or_add_shard();
+            cached_id = m_id;
+        }
+        return *cached_shard_p;
+    }
+
+    shard* find_or_add_shard() {
+        auto id = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto shard_p : m_shards) {
+            if (shard_p->owner == id) return shard_p;
+        }
+        auto shard_p = new shard(id);
+        try {
+            m_shards.push_back(shard_p);
+        } catch (...) {
+            delete shard_p;
+            throw;
+        }
+        return shard_p;
+    }
+
+    // Copies all shards into result, returns the boundaries of the shards in it (shard_count() + 1 values)
+    my_vector<size_t> gather(const parallel_policy& policy, my_vector<T>& result) const {
+        my_vector<size_t> offsets;
+        offsets.reserve(m_shards.size() + 1);
+        offsets.push_back(0);
+        for (auto shard_p : m_shards) {
+            offsets.push_back(offsets.back() + shard_p->items.size());
+        }
+        result.reserve(offsets.back());
+        result.resize(policy, offsets.back());
+        detail::parallel_for(policy, offsets.back(), [this, &offsets, &result](size_t first, size_t last) {
+            // The shard holding element first
+            size_t s = std::upper_bound(offsets.data(), offsets.data() + offsets.size(), first) - offsets.data() - 1;
+            while (first < last) {
+                auto upto = std::min(last, offsets[s + 1]);
+                std::copy(m_shards[s]->items.data() + (first - offsets[s]), m_shards[s]->items.data() + (upto - offsets[s]),
+                          result.data() + first);
+                first = upto;
+                ++s;
+            }
+        });
+        return offsets;
+    }
+
+private:
+    uint64_t m_id;
+    std::mutex m_mutex;
+    my_vector<shard*> m_shards;
+};
+
+}
+
+#endif // MY_SHARDED_VECTOR_H
@@ -0,0 +1,87 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_sharded_vector.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cpp_training;
+
+namespace {
+
+// Fills the sharded vector with values [0, threads * per_thread) from several threads, in shuffled order
+void fill(my_sharded_vector<int>& vec, int threads, int per_thread) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&vec, t, threads, per_thread] {
+            for (int i = per_thread - 1; i >= 0; --i) vec.push_back(i * threads + t);
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+}
+
+TEST(MyShardedVectorTest, SingleThread) {
+    my_sharded_vector<std::string> vec;
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.shard_count(), 0);
+    EXPECT_TRUE(vec.collect().is_empty());
+
+    vec.push_back("a");
+    vec.emplace_back("b");
+    vec.local().push_back("c");
+    EXPECT_EQ(vec.shard_count(), 1);
+    EXPECT_EQ(vec.collect(), (my_vector<std::string>{"a", "b", "c"}));
+
+    // Another instance gets its own shard for the same thread
+    my_sharded_vector<std::string> other;
+    other.push_back("x");
+    vec.push_back("d");
+    EXPECT_EQ(other.collect(), (my_vector<std::string>{"x"}));
+    EXPECT_EQ(vec.size(), 4);
+
+    vec.clear();
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.shard_count(), 1);
+}
+
+TEST(MyShardedVectorTest, Collect) {
+    my_sharded_vector<int> vec;
+    fill(vec, 4, 50000);
+    EXPECT_EQ(vec.shard_count(), 4);
+    EXPECT_EQ(vec.size(), 200000);
+
+    auto all = vec.collect(parallel_policy{4});
+    EXPECT_EQ(all.size(), 200000);
+    std::sort(all.data(), all.data() + all.size());
+    for (int i = 0; i < 200000; ++i) {
+        ASSERT_EQ(all[i], i);
+    }
+
+    std::atomic<long> sum {0};
+    vec.for_each([&sum](int v) { sum += v; });
+    EXPECT_EQ(sum.load(), 200000L * 199999 / 2);
+}
+
+TEST(MyShardedVectorTest, MergeSorted) {
+    my_sharded_vector<int> vec;
+    fill(vec, 5, 30001);
+    auto sorted = vec.merge_sorted(std::less<int>(), parallel_policy{3});
+    EXPECT_EQ(sorted.size(), 150005);
+    for (int i = 0; i < 150005; ++i) {
+        ASSERT_EQ(sorted[i], i);
+    }
+
+    auto desc = vec.merge_sorted(std::greater<int>());
+    EXPECT_EQ(desc.front(), 150004);
+    EXPECT_EQ(desc.back(), 0);
+
+    my_sharded_vector<int> single;
+    single.push_back(3);
+    single.push_back(1);
+    EXPECT_EQ(single.merge_sorted(), (my_vector<int>{1, 3}));
+}
@@ -0,0 +1,163 @@
+#ifndef MY_SLOT_MAP_H
+#define MY_SLOT_MAP_H
+
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#include "my_vector.h"
+
+// Interface after P0661 : https://wg21.link/p0661
+
+namespace cpp_training {
+
+// Container of values addressed by stable handles.
+// Values are kept dense in a my_vector, iteration is a plain array walk in unspecified order.
+// A handle is {slot index, generation}: slots map to the position of their value and are reused through
+// a free list, erasing bumps the slot's generation so old handles to it stop resolving.
+// Insert, erase and lookup are O(1); erase moves the last value into the hole.
+template <typename T>
+class my_slot_map {
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+
+    struct slot {
+        uint32_t position;      // Of the value when in use, of the next free slot otherwise
+        uint32_t generation;
+    };
+
+public:
+    struct handle {
+        uint32_t index = NoSlot;
+        uint32_t generation = 0;
+
+        bool operator == (const handle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+        bool operator != (const handle& rhs) const { return !(*this == rhs); }
+    };
+
+    using value_type = T;
+    using iterator = typename my_vector<T>::iterator;
+    using const_iterator = typename my_vector<T>::const_iterator;
+
+public:
+
+    size_t size() const { return m_values.size(); }
+
+    bool is_empty() const { return m_values.is_empty(); }
+
+    void reserve(size_t new_cap) {
+        m_values.reserve(new_cap);
+        m_owners.reserve(new_cap);
+        m_slots.reserve(new_cap);
+    }
+
+    handle insert(const T& value) { return emplace(value); }
+
+    handle insert(T&& value) { return emplace(std::move(value)); }
+
+    template< class... Args >
+    handle emplace( Args&&... args ) {
+        if (m_values.size() == NoSlot) throw std::length_error("slot map is full");
+        m_values.emplace_back(std::forward<Args>(args)...);
+        uint32_t index;
+        try {
+            if (m_free_head == NoSlot) {
+                m_slots.push_back(slot{0, 0});
+                index = static_cast<uint32_t>(m_slots.size() - 1);
+            } else {
+                index = m_free_head;
+            }
+            m_owners.push_back(index);
+        } catch (...) {
+            m_values.pop_back();
+            throw;
+        }
+        if (index == m_free_head) m_free_head = m_slots[index].position;
+        m_slots[index].position = static_cast<uint32_t>(m_values.size() - 1);
+        return handle{index, m_slots[index].generation};
+    }
+
+    // Returns false if the handle doesn't resolve
+    bool erase(handle h) {
+        if (!contains(h)) return false;
+        auto position = m_slots[h.index].position;
+        auto last = static_cast<uint32_t>(m_values.size() - 1);
+        if (position != last) {
+            m_values[position] = std::move(m_values[last]);
+            m_owners[position] = m_owners[last];
+            m_slots[m_owners[position]].position = position;
+        }
+        m_values.pop_back();
+        m_owners.pop_back();
+        release(h.index);
+        return true;
+    }
+
+    bool contains(handle h) const {
+        return h.index < m_slots.size() && m_slots[h.index].generation == h.generation;
+    }
+
+    // Value of the handle, nullptr if it doesn't resolve
+    T* find(handle h) { return contains(h) ? &m_values[m_slots[h.index].position] : nullptr; }
+
+    const T* find(handle h) const { return contains(h) ? &m_values[m_slots[h.index].position] : nullptr; }
+
+    // The handle must resolve
+    T& operator [] (handle h) { return m_values[m_slots[h.index].position]; }
+
+    const T& operator [] (handle h) const { return m_values[m_slots[h.index].position]; }
+
+    T& at(handle h) {
+        if (!contains(h)) throw std::out_of_range("stale or invalid handle");
+        return (*this)[h];
+    }
+
+    const T& at(handle h) const {
+        if (!contains(h)) throw std::out_of_range("stale or invalid handle");
+        return (*this)[h];
+    }
+
+    // Handle of the value at position i of the dense storage, e.g. while iterating
+    handle handle_at(size_t i) const {
+        auto index = m_owners[i];
+        return handle{index, m_slots[index].generation};
+    }
+
+    // Invalidates all handles, keeps the slots for reuse
+    void clear() {
+        for (auto index : m_owners) release(index);
+        m_values.clear();
+        m_owners.clear();
+    }
+
+    T* data() noexcept { return m_values.data(); }
+
+    const T* data() const noexcept { return m_values.data(); }
+
+    iterator begin() noexcept { return m_values.begin(); }
+
+    iterator end() noexcept { return m_values.end(); }
+
+    const_iterator begin() const noexcept { return m_values.cbegin(); }
+
+    const_iterator end() const noexcept { return m_values.cend(); }
+
+    const_iterator cbegin() const noexcept { return m_values.cbegin(); }
+
+    const_iterator cend() const noexcept { return m_values.cend(); }
+
+private:
+    void release(uint32_t index) {
+        ++m_slots[index].generation;
+        m_slots[index].position = m_free_head;
+        m_free_head = index;
+    }
+
+private:
+    my_vector<T> m_values;
+    my_vector<uint32_t> m_owners;       // Slot of every value
+    my_vector<slot> m_slots;
+    uint32_t m_free_head = NoSlot;
+};
+
+}
+
+#endif // MY_SLOT_MAP_H
@@ -0,0 +1,75 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_slot_map.h"
+#include <map>
+#include <random>
+#include <string>
+
+using namespace cpp_training;
+
+TEST(MySlotMapTest, HandlesStayValid) {
+    my_slot_map<std::string> map;
+    auto a = map.insert("a");
+    auto b = map.emplace("b");
+    auto c = map.insert("c");
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map[b], "b");
+
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_FALSE(map.contains(a));
+    EXPECT_EQ(map.find(a), nullptr);
+    EXPECT_THROW(map.at(a), std::out_of_range);
+    // The last value moved into the hole, handles still resolve
+    EXPECT_EQ(map[c], "c");
+    EXPECT_EQ(map.at(b), "b");
+    EXPECT_EQ(map.size(), 2);
+
+    // The freed slot is reused with a new generation
+    auto d = map.insert("d");
+    EXPECT_EQ(d.index, a.index);
+    EXPECT_NE(d, a);
+    EXPECT_FALSE(map.contains(a));
+    EXPECT_EQ(*map.find(d), "d");
+
+    EXPECT_FALSE(map.contains(my_slot_map<std::string>::handle{}));
+}
+
+TEST(MySlotMapTest, DenseIteration) {
+    my_slot_map<int> map;
+    for (int i = 0; i < 10; ++i) map.insert(i);
+    for (size_t i = 0; i < map.size(); ++i) {
+        EXPECT_EQ(map[map.handle_at(i)], map.data()[i]);
+    }
+    int sum = 0;
+    for (auto value : map) sum += value;
+    EXPECT_EQ(sum, 45);
+
+    auto first = map.handle_at(0);
+    map.clear();
+    EXPECT_TRUE(map.is_empty());
+    EXPECT_FALSE(map.contains(first));
+    auto again = map.insert(7);
+    EXPECT_EQ(map[again], 7);
+}
+
+TEST(MySlotMapTest, MatchesModel) {
+    my_slot_map<int> map;
+    std::map<int, my_slot_map<int>::handle> model;
+    std::mt19937 gen(5);
+    for (int i = 0; i < 5000; ++i) {
+        if (model.empty() || gen() % 3) {
+            model[i] = map.insert(i);
+        } else {
+            auto it = model.begin();
+            std::advance(it, gen() % model.size());
+            EXPECT_TRUE(map.erase(it->second));
+            model.erase(it);
+        }
+    }
+    ASSERT_EQ(map.size(), model.size());
+    for (auto& item : model) {
+        ASSERT_EQ(map.at(item.second), item.first);
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef MY_SPAN_H
+#define MY_SPAN_H
+
+#include <cstddef>
+#include <type_traits>
+
+// Interface : https://en.cppreference.com/w/cpp/container/span (dynamic extent only)
+
+namespace cpp_training {
+
+// Non owning view of a contiguous sequence, T may be const
+template <typename T>
+class my_span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using reference = T&;
+    using pointer = T*;
+    using iterator = T*;
+
+public:
+
+    my_span() {
+    }
+
+    my_span(T* data, size_t size) : m_data_p(data), m_size(size) {
+    }
+
+    // my_span<T> converts to my_span<const T>
+    template <typename U, std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value, int> = 0>
+    my_span(const my_span<U>& rhs) : m_data_p(rhs.data()), m_size(rhs.size()) {
+    }
+
+    T* data() const noexcept { return m_data_p; }
+
+    size_t size() const noexcept { return m_size; }
+
+    size_t size_bytes() const noexcept { return m_size * sizeof(T); }
+
+    bool is_empty() const noexcept { return m_size == 0; }
+
+    T& operator [] (size_t i) const { return m_data_p[i]; }
+
+    T& front() const { return m_data_p[0]; }
+
+    T& back() const { return m_data_p[m_size - 1]; }
+
+    iterator begin() const noexcept { return m_data_p; }
+
+    iterator end() const noexcept { return m_data_p + m_size; }
+
+    my_span subspan(size_t offset, size_t count) const {
+        return my_span(m_data_p + offset, count);
+    }
+
+    my_span first(size_t count) const {
+        return my_span(m_data_p, count);
+    }
+
+    my_span last(size_t count) const {
+        return my_span(m_data_p + m_size - count, count);
+    }
+
+private:
+    T * m_data_p = nullptr;
+    size_t m_size = 0;
+};
+
+}
+
+#endif // MY_SPAN_H
@@ -0,0 +1,143 @@
+#ifndef MY_SPARSE_SET_H
+#define MY_SPARSE_SET_H
+
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_span.h"
+
+namespace cpp_training {
+
+// Set of integer ids (Briggs and Torczon's sparse set).
+// The ids are kept dense and unordered in a my_vector, a sparse array maps an id to its position there.
+// The sparse array is split in pages of PageSize entries allocated on first use,
+// so a few large ids don't cost an array as large as the id space.
+// Insert, erase and contains are O(1); clear() is O(1) too, as stale sparse entries are detected
+// by checking that the dense entry they point at holds the id.
+template <typename Id = uint32_t>
+class my_sparse_set {
+    static_assert(std::is_unsigned<Id>::value, "my_sparse_set needs an unsigned id type");
+
+public:
+    static constexpr size_t PageSize = 4096;
+    using value_type = Id;
+    using const_iterator = typename my_vector<Id>::const_iterator;
+
+public:
+
+    my_sparse_set() {
+    }
+
+    // Delegates, so the destructor frees the pages copied so far if an allocation throws
+    my_sparse_set(const my_sparse_set& rhs) : my_sparse_set() {
+        m_dense = rhs.m_dense;
+        m_pages.reserve(rhs.m_pages.size());
+        for (auto page : rhs.m_pages) {
+            m_pages.push_back(nullptr);
+            if (page) {
+                m_pages.back() = new Id[PageSize];
+                std::copy(page, page + PageSize, m_pages.back());
+            }
+        }
+    }
+
+    my_sparse_set(my_sparse_set&& rhs) noexcept {
+        swap(rhs);
+    }
+
+    ~my_sparse_set() noexcept {
+        for (auto page : m_pages) delete[] page;
+    }
+
+    my_sparse_set& operator = (const my_sparse_set& rhs) {
+        my_sparse_set tmp (rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    my_sparse_set& operator = (my_sparse_set&& rhs) noexcept {
+        my_sparse_set tmp (std::move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(my_sparse_set& rhs) noexcept {
+        m_dense.swap(rhs.m_dense);
+        m_pages.swap(rhs.m_pages);
+    }
+
+    size_t size() const { return m_dense.size(); }
+
+    bool is_empty() const { return m_dense.is_empty(); }
+
+    void reserve(size_t new_cap) { m_dense.reserve(new_cap); }
+
+    // Returns false if id is already in the set
+    bool insert(Id id) {
+        if (contains(id)) return false;
+        auto page = page_of(id);
+        m_dense.push_back(id);
+        page[id % PageSize] = static_cast<Id>(m_dense.size() - 1);
+        return true;
+    }
+
+    // Returns false if id is not in the set. The last id takes the place of the erased one
+    bool erase(Id id) {
+        if (!contains(id)) return false;
+        auto position = entry(id);
+        auto last = m_dense.back();
+        m_dense[position] = last;
+        m_pages[last / PageSize][last % PageSize] = position;
+        m_dense.pop_back();
+        return true;
+    }
+
+    bool contains(Id id) const {
+        auto p = id / PageSize;
+        if (p >= m_pages.size() || !m_pages[p]) return false;
+        auto position = entry(id);
+        return position < m_dense.size() && m_dense[position] == id;
+    }
+
+    // Position of id in ids(), the id must be in the set
+    size_t index_of(Id id) const { return entry(id); }
+
+    // Keeps the pages, the sparse entries become stale
+    void clear() { m_dense.clear(); }
+
+    // The ids in insertion order as long as nothing was erased, contiguous for vectorized loops
+    my_span<const Id> ids() const { return my_span<const Id>(m_dense.data(), m_dense.size()); }
+
+    const Id* data() const noexcept { return m_dense.data(); }
+
+    const_iterator begin() const noexcept { return m_dense.cbegin(); }
+
+    const_iterator end() const noexcept { return m_dense.cend(); }
+
+    const_iterator cbegin() const noexcept { return m_dense.cbegin(); }
+
+    const_iterator cend() const noexcept { return m_dense.cend(); }
+
+private:
+    Id entry(Id id) const { return m_pages[id / PageSize][id % PageSize]; }
+
+    Id* page_of(Id id) {
+        auto p = id / PageSize;
+        if (p >= m_pages.size()) m_pages.resize(p + 1, nullptr);
+        // The content of a new page doesn't matter, it is zeroed so no indeterminate value is ever read
+        if (!m_pages[p]) m_pages[p] = new Id[PageSize]();
+        return m_pages[p];
+    }
+
+private:
+    my_vector<Id> m_dense;
+    // Owned, null until the first id of the page is inserted. Raw pointers, so growing the table
+    // is a plain copy of pointers instead of moving page vectors
+    my_vector<Id*> m_pages;
+};
+
+}
+
+#endif // MY_SPARSE_SET_H
@@ -0,0 +1,84 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_sparse_set.h"
+#include <random>
+#include <set>
+
+using namespace cpp_training;
+
+TEST(MySparseSetTest, InsertErase) {
+    my_sparse_set<> set;
+    EXPECT_TRUE(set.is_empty());
+    EXPECT_FALSE(set.contains(5));
+    EXPECT_TRUE(set.insert(5));
+    EXPECT_FALSE(set.insert(5));
+    EXPECT_TRUE(set.insert(1000000));
+    EXPECT_TRUE(set.insert(0));
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_TRUE(set.contains(1000000));
+    EXPECT_FALSE(set.contains(999999));
+    EXPECT_EQ(set.index_of(0), 2);
+
+    EXPECT_TRUE(set.erase(5));
+    EXPECT_FALSE(set.erase(5));
+    EXPECT_FALSE(set.contains(5));
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_EQ(set.ids()[0], 0);
+    EXPECT_EQ(set.index_of(1000000), 1);
+}
+
+TEST(MySparseSetTest, ClearIsConstant) {
+    my_sparse_set<uint16_t> set;
+    for (uint16_t id = 0; id < 100; ++id) set.insert(id * 7);
+    set.clear();
+    EXPECT_TRUE(set.is_empty());
+    for (uint16_t id = 0; id < 100; ++id) {
+        ASSERT_FALSE(set.contains(id * 7));
+    }
+    // Stale sparse entries must not confuse new inserts
+    set.insert(14);
+    set.insert(700);
+    EXPECT_TRUE(set.contains(14));
+    EXPECT_FALSE(set.contains(7));
+    EXPECT_EQ(set.size(), 2);
+}
+
+TEST(MySparseSetTest, PagesCopyAndMove) {
+    // Ids far apart grow the page table several times
+    my_sparse_set<> set;
+    for (uint32_t p = 0; p < 64; p += 3) set.insert(p * my_sparse_set<>::PageSize + p);
+    my_sparse_set<> copy(set);
+    set.erase(3 * my_sparse_set<>::PageSize + 3);
+    EXPECT_TRUE(copy.contains(3 * my_sparse_set<>::PageSize + 3));
+    EXPECT_FALSE(set.contains(3 * my_sparse_set<>::PageSize + 3));
+    EXPECT_EQ(copy.size(), set.size() + 1);
+
+    my_sparse_set<> moved(std::move(copy));
+    EXPECT_TRUE(copy.is_empty());
+    EXPECT_FALSE(copy.contains(0));
+    copy = moved;
+    EXPECT_TRUE(copy.insert(5));
+    EXPECT_FALSE(moved.contains(5));
+    EXPECT_EQ(copy.index_of(63 * my_sparse_set<>::PageSize + 63), moved.index_of(63 * my_sparse_set<>::PageSize + 63));
+}
+
+TEST(MySparseSetTest, MatchesStdSet) {
+    my_sparse_set<> set;
+    std::set<uint32_t> model;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t id = gen() % 50000;
+        if (gen() % 2) {
+            EXPECT_EQ(set.insert(id), model.insert(id).second);
+        } else {
+            EXPECT_EQ(set.erase(id), model.erase(id) == 1);
+        }
+    }
+    ASSERT_EQ(set.size(), model.size());
+    std::set<uint32_t> dense(set.begin(), set.end());
+    EXPECT_EQ(dense, model);
+    for (auto id : model) {
+        ASSERT_EQ(set.ids()[set.index_of(id)], id);
+    }
+}
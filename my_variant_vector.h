@@ -0,0 +1,204 @@
+#ifndef MY_VARIANT_VECTOR_H
+#define MY_VARIANT_VECTOR_H
+
+#include <tuple>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+#include "my_span.h"
+
+namespace cpp_training {
+
+namespace detail {
+
+// Position of T in Ts, sizeof...(Ts) if it isn't there
+template <typename T, typename... Ts>
+struct type_index_of;
+
+template <typename T>
+struct type_index_of<T> : std::integral_constant<size_t, 0> {};
+
+template <typename T, typename First, typename... Rest>
+struct type_index_of<T, First, Rest...>
+    : std::integral_constant<size_t, std::is_same<T, First>::value ? 0 : 1 + type_index_of<T, Rest...>::value> {};
+
+}
+
+// Replacement for my_vector<std::variant<Ts...>> which keeps every alternative in its own my_vector,
+// so no element is padded to the largest alternative, plus an order index of {alternative, position}.
+// visit_all(fn) walks the alternatives one after the other in tight loops without a branch per element;
+// visit_in_order(fn) follows the insertion order through the index, as visiting the variants would.
+// The order within an alternative is the insertion order, so pop_back() is O(1).
+template <typename... Ts>
+class my_variant_vector {
+    static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) < UINT8_MAX, "my_variant_vector needs 1 to 254 alternatives");
+
+    struct entry {
+        uint32_t position;      // In the my_vector of the alternative
+        uint8_t alternative;
+    };
+
+    template <typename T>
+    static constexpr size_t index_of = detail::type_index_of<T, Ts...>::value;
+
+public:
+    using variant_type = std::variant<Ts...>;
+
+public:
+
+    my_variant_vector() {
+    }
+
+    explicit my_variant_vector(const my_vector<variant_type>& values) {
+        m_order.reserve(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            std::visit([this](const auto& value) { push_back(value); }, values[i]);
+        }
+    }
+
+    size_t size() const { return m_order.size(); }
+
+    bool is_empty() const { return m_order.is_empty(); }
+
+    // Number of elements holding T
+    template <typename T>
+    size_t size() const { return segment<T>().size(); }
+
+    template <typename T, class... Args>
+    T& emplace_back(Args&&... args) {
+        static_assert(index_of<T> < sizeof...(Ts), "T is not an alternative");
+        auto& values = std::get<index_of<T>>(m_segments);
+        if (values.size() >= UINT32_MAX) throw std::length_error("too many elements of one alternative");
+        m_order.reserve(m_order.size() + 1);
+        values.emplace_back(std::forward<Args>(args)...);
+        m_order.push_back(entry{static_cast<uint32_t>(values.size() - 1), static_cast<uint8_t>(index_of<T>)});
+        return values.back();
+    }
+
+    template <typename T>
+    std::decay_t<T>& push_back(T&& value) {
+        return emplace_back<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    void pop_back() {
+        if (is_empty()) return;
+        pop_from(m_order.back().alternative, std::index_sequence_for<Ts...>());
+        m_order.pop_back();
+    }
+
+    void clear() {
+        m_order.clear();
+        std::apply([](auto&... values) { (values.clear(), ...); }, m_segments);
+    }
+
+    // Index of the alternative held by element i, as std::variant::index()
+    size_t index(size_t i) const { return m_order[i].alternative; }
+
+    template <typename T>
+    bool holds(size_t i) const { return m_order[i].alternative == index_of<T>; }
+
+    // Element i, which must hold T
+    template <typename T>
+    T& get(size_t i) {
+        if (!holds<T>(i)) throw std::bad_variant_access();
+        return std::get<index_of<T>>(m_segments)[m_order[i].position];
+    }
+
+    template <typename T>
+    const T& get(size_t i) const {
+        if (!holds<T>(i)) throw std::bad_variant_access();
+        return std::get<index_of<T>>(m_segments)[m_order[i].position];
+    }
+
+    variant_type to_variant(size_t i) const {
+        variant_type result;
+        visit(i, [&result](const auto& value) { result = value; });
+        return result;
+    }
+
+    my_vector<variant_type> to_vector() const {
+        my_vector<variant_type> result;
+        result.reserve(size());
+        for (size_t i = 0; i < size(); ++i) result.push_back(to_variant(i));
+        return result;
+    }
+
+    // The elements holding T, in insertion order
+    template <typename T>
+    my_span<T> segment() {
+        auto& values = std::get<index_of<T>>(m_segments);
+        return my_span<T>(values.data(), values.size());
+    }
+
+    template <typename T>
+    my_span<const T> segment() const {
+        auto& values = std::get<index_of<T>>(m_segments);
+        return my_span<const T>(values.data(), values.size());
+    }
+
+    // Calls fn with element i
+    template <typename Fn>
+    void visit(size_t i, Fn&& fn) {
+        visit_entry(m_order[i], fn, std::index_sequence_for<Ts...>());
+    }
+
+    template <typename Fn>
+    void visit(size_t i, Fn&& fn) const {
+        visit_entry(m_order[i], fn, std::index_sequence_for<Ts...>());
+    }
+
+    // Calls fn for every element, alternative by alternative
+    template <typename Fn>
+    void visit_all(Fn&& fn) {
+        std::apply([&fn](auto&... values) { (for_each_value(values, fn), ...); }, m_segments);
+    }
+
+    template <typename Fn>
+    void visit_all(Fn&& fn) const {
+        std::apply([&fn](const auto&... values) { (for_each_value(values, fn), ...); }, m_segments);
+    }
+
+    // Calls fn for every element in insertion order
+    template <typename Fn>
+    void visit_in_order(Fn&& fn) {
+        for (auto& e : m_order) visit_entry(e, fn, std::index_sequence_for<Ts...>());
+    }
+
+    template <typename Fn>
+    void visit_in_order(Fn&& fn) const {
+        for (auto& e : m_order) visit_entry(e, fn, std::index_sequence_for<Ts...>());
+    }
+
+private:
+    template <typename Values, typename Fn>
+    static void for_each_value(Values& values, Fn& fn) {
+        auto data = values.data();
+        for (size_t i = 0; i < values.size(); ++i) fn(data[i]);
+    }
+
+    template <typename Fn, size_t... Is>
+    void visit_entry(const entry& e, Fn& fn, std::index_sequence<Is...>) {
+        (void)((e.alternative == Is && (fn(std::get<Is>(m_segments)[e.position]), true)) || ...);
+    }
+
+    template <typename Fn, size_t... Is>
+    void visit_entry(const entry& e, Fn& fn, std::index_sequence<Is...>) const {
+        (void)((e.alternative == Is && (fn(std::get<Is>(m_segments)[e.position]), true)) || ...);
+    }
+
+    template <size_t... Is>
+    void pop_from(size_t alternative, std::index_sequence<Is...>) {
+        (void)((alternative == Is && (std::get<Is>(m_segments).pop_back(), true)) || ...);
+    }
+
+private:
+    std::tuple<my_vector<Ts>...> m_segments;
+    my_vector<entry> m_order;
+};
+
+}
+
+#endif // MY_VARIANT_VECTOR_H
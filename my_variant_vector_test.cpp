@@ -0,0 +1,101 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_variant_vector.h"
+#include <random>
+#include <string>
+
+using namespace cpp_training;
+
+namespace {
+
+struct circle {
+    double r;
+};
+
+struct rect {
+    double w, h;
+};
+
+using shape_vector = my_variant_vector<circle, rect, std::string>;
+
+}
+
+TEST(MyVariantVectorTest, Basics) {
+    shape_vector shapes;
+    EXPECT_TRUE(shapes.is_empty());
+    shapes.push_back(circle{1.0});
+    shapes.push_back(rect{2.0, 3.0});
+    shapes.emplace_back<std::string>("label");
+    shapes.push_back(circle{2.0});
+    EXPECT_EQ(shapes.size(), 4);
+    EXPECT_EQ(shapes.size<circle>(), 2);
+    EXPECT_EQ(shapes.index(1), 1);
+    EXPECT_TRUE(shapes.holds<std::string>(2));
+    EXPECT_EQ(shapes.get<circle>(3).r, 2.0);
+    EXPECT_THROW(shapes.get<rect>(0), std::bad_variant_access);
+    EXPECT_EQ(std::get<std::string>(shapes.to_variant(2)), "label");
+    EXPECT_EQ(shapes.segment<circle>()[1].r, 2.0);
+
+    double area = 0;
+    shapes.visit_all([&area](const auto& s) {
+        using S = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same<S, circle>::value) area += 3 * s.r * s.r;
+        if constexpr (std::is_same<S, rect>::value) area += s.w * s.h;
+    });
+    EXPECT_EQ(area, 3 + 12 + 6);
+
+    std::string order;
+    shapes.visit_in_order([&order](const auto& s) {
+        using S = std::decay_t<decltype(s)>;
+        order += std::is_same<S, circle>::value ? 'c' : std::is_same<S, rect>::value ? 'r' : 's';
+    });
+    EXPECT_EQ(order, "crsc");
+
+    shapes.pop_back();
+    shapes.pop_back();
+    EXPECT_EQ(shapes.size(), 2);
+    EXPECT_EQ(shapes.size<std::string>(), 0);
+    EXPECT_EQ(shapes.size<circle>(), 1);
+    shapes.clear();
+    EXPECT_TRUE(shapes.is_empty());
+    EXPECT_EQ(shapes.size<rect>(), 0);
+}
+
+TEST(MyVariantVectorTest, MatchesVariantVector) {
+    my_vector<shape_vector::variant_type> model;
+    std::mt19937 gen(46);
+    for (int i = 0; i < 5000; ++i) {
+        switch (gen() % 3) {
+        case 0: model.push_back(circle{static_cast<double>(i)}); break;
+        case 1: model.push_back(rect{static_cast<double>(i), 2.0}); break;
+        default: model.push_back(std::to_string(i));
+        }
+    }
+    shape_vector shapes(model);
+    ASSERT_EQ(shapes.size(), model.size());
+    auto back = shapes.to_vector();
+    for (size_t i = 0; i < model.size(); ++i) {
+        ASSERT_EQ(back[i].index(), model[i].index());
+        ASSERT_EQ(shapes.index(i), model[i].index());
+    }
+
+    // Visiting alternative by alternative sees the same multiset as visiting the variants
+    double expected = 0, total = 0;
+    auto weigh = [](const auto& s) -> double {
+        using S = std::decay_t<decltype(s)>;
+        if constexpr (std::is_same<S, circle>::value) return s.r;
+        else if constexpr (std::is_same<S, rect>::value) return s.w * s.h;
+        else return static_cast<double>(s.size());
+    };
+    for (size_t i = 0; i < model.size(); ++i) expected += std::visit(weigh, model[i]);
+    shapes.visit_all([&](auto& s) { total += weigh(s); });
+    EXPECT_EQ(total, expected);
+
+    size_t i = 0;
+    shapes.visit_in_order([&](const auto& s) {
+        ASSERT_EQ(weigh(s), std::visit(weigh, model[i]));
+        ++i;
+    });
+    EXPECT_EQ(i, model.size());
+}
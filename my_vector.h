@@ -7,11 +7,18 @@
 #include <cstring>
 #include <cstddef>
 #include <stdexcept>
+#include <type_traits>
+#include <new>
+#include "my_parallel.h"
 
 // Interface : https://en.cppreference.com/w/cpp/container/vector
 
 namespace cpp_training {
 
+// Base of the lazy element-wise expressions, see my_vector_expr.h
+template <typename E>
+struct my_vector_expr;
+
 template <typename T>
 class my_vector {
     class my_iterator;
@@ -36,13 +43,30 @@ public:
 
     explicit my_vector(size_t size, const T& init_value = T())
         : m_size(size), m_capacity (size * CapacityFactor) {
-        auto raw_buff_p = ::operator new (m_capacity * sizeof(T));
+        auto raw_buff_p = allocate (m_capacity);
         m_buffer_p = static_cast<T*>(raw_buff_p);
         for (int i =0; i<m_size; ++i) {
             new (m_buffer_p + i) T {init_value};
         }
     }
 
+    // Parallel version of my_vector(size, init_value).
+    // Elements are constructed by several threads, so the pages of the buffer are first touched
+    // (and placed on the NUMA node of) the threads constructing them.
+    my_vector(const parallel_policy& policy, size_t size, const T& init_value = T())
+        : m_size(size), m_capacity (size * CapacityFactor) {
+        auto raw_buff_p = allocate (m_capacity);
+        m_buffer_p = static_cast<T*>(raw_buff_p);
+        try {
+            detail::parallel_uninitialized_construct(policy, m_buffer_p, m_size, [&init_value](T* p, size_t) {
+                new (p) T {init_value};
+            });
+        } catch (...) {
+            deallocate (m_buffer_p);
+            throw;
+        }
+    }
+
     ~my_vector() noexcept {
         destroy();
     }
@@ -51,6 +75,28 @@ public:
         grow_and_copy_from<T>(rhs.capacity(), rhs);
     }
 
+    // Parallel copy constructor
+    my_vector(const parallel_policy& policy, const my_vector& rhs)
+        : m_size(rhs.m_size), m_capacity(rhs.m_capacity) {
+        auto raw_buff_p = allocate (m_capacity);
+        m_buffer_p = static_cast<T*>(raw_buff_p);
+        try {
+            parallel_copy_from<T>(policy, rhs);
+        } catch (...) {
+            deallocate (m_buffer_p);
+            throw;
+        }
+    }
+
+    // Sequential versions of the policy constructors, so generic code can pass seq or par
+    my_vector(const sequenced_policy&, size_t size, const T& init_value = T())
+        : my_vector(size, init_value) {
+    }
+
+    my_vector(const sequenced_policy&, const my_vector& rhs)
+        : my_vector(rhs) {
+    }
+
     my_vector(iterator begin, iterator end) {
         reserve((end - begin) * CapacityFactor);
         while (begin != end) {
@@ -58,7 +104,8 @@ public:
         }
     }
 
-    template <typename InIter>
+    // Not an iterator constructor for my_vector<int>(5, 0)
+    template <typename InIter, std::enable_if_t<!std::is_integral<InIter>::value, int> = 0>
     my_vector(InIter begin, InIter end) {
         for (; begin != end; ++begin) {
             push_back(*begin);
@@ -71,7 +118,7 @@ public:
 
     my_vector( std::initializer_list<T> lst )
         : m_size{lst.size()}, m_capacity {static_cast<size_t>(m_size* CapacityFactor)} {
-        auto raw_buff_p = ::operator new (m_capacity * sizeof(T));
+        auto raw_buff_p = allocate (m_capacity);
         m_buffer_p = static_cast<T*>(raw_buff_p);
         auto it = lst.begin();
         for (int i =0; i<m_size; ++i) {
@@ -95,6 +142,32 @@ public:
         return *this;
     }
 
+    // Evaluates an element-wise expression (my_vector_expr.h) in one loop, without temporaries
+    template <typename E>
+    explicit my_vector(const my_vector_expr<E>& expr) {
+        auto& e = expr.self();
+        reserve(e.size());
+        for (size_t i = 0; i < e.size(); ++i) {
+            new (m_buffer_p + i) T { static_cast<T>(e[i]) };
+            ++m_size;
+        }
+    }
+
+    template <typename E>
+    my_vector& operator = (const my_vector_expr<E>& expr) {
+        auto& e = expr.self();
+        if (e.size() != m_size) {
+            // The expression may read this vector, so the result is built aside
+            my_vector tmp (expr);
+            swap(tmp);
+        } else {
+            // Element i only depends on element i of the operands, so this vector can be one of them
+            auto dst = m_buffer_p;
+            for (size_t i = 0; i < m_size; ++i) dst[i] = static_cast<T>(e[i]);
+        }
+        return *this;
+    }
+
     void reserve(size_t new_cap) {
         if (new_cap > m_capacity) {
             grow_and_copy_from<T>(new_cap, *this);
@@ -194,12 +267,63 @@ public:
         } else if (count > m_size) {
             if (count > m_capacity)
                 reserve (count * CapacityFactor);
-            for (int i=m_size; i<(count-m_size); ++i)
-                m_buffer_p[i] = value;
+            for (size_t i = m_size; i < count; ++i)
+                new (m_buffer_p + i) T {value};
+        }
+        m_size = count;
+    }
+
+    // Parallel version of resize(count, value), appended elements are constructed by several threads
+    void resize(const parallel_policy& policy, size_t count, const T& value = T()) {
+        if (count <= m_size) {
+            resize(count, value);
+            return;
         }
+        if (count > m_capacity)
+            reserve (count * CapacityFactor);
+        detail::parallel_uninitialized_construct(policy, m_buffer_p + m_size, count - m_size, [&value](T* p, size_t) {
+            new (p) T {value};
+        });
         m_size = count;
     }
 
+    void resize(const sequenced_policy&, size_t count, const T& value = T()) {
+        resize(count, value);
+    }
+
+    // After std::basic_string::resize_and_overwrite (C++23): makes room for count elements, keeping the current ones,
+    // op(data(), count) writes the first ones and returns their number n <= count, which becomes size().
+    // For POD types the elements past size() are not initialized before op, so it must not read what it didn't write.
+    template <typename Op>
+    void resize_and_overwrite(size_t count, Op op) {
+        if constexpr (std::is_pod<T>::value) {
+            if (count > m_capacity)
+                reserve (count);
+            m_size = op(m_buffer_p, count);
+        } else {
+            resize(count);
+            resize(op(m_buffer_p, count));
+        }
+    }
+
+    // Assigns value to every element of the container
+    void fill(const T& value) {
+        for (size_t i = 0; i < m_size; ++i)
+            m_buffer_p[i] = value;
+    }
+
+    // Parallel version of fill(value)
+    void fill(const parallel_policy& policy, const T& value) {
+        detail::parallel_for(policy, m_size, [this, &value](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i)
+                m_buffer_p[i] = value;
+        });
+    }
+
+    void fill(const sequenced_policy&, const T& value) {
+        fill(value);
+    }
+
     //Requests the removal of unused capacity.
     // It is a non-binding request to reduce capacity() to size(). It depends on the implementation whether the request is fulfilled.
     // If reallocation occurs, all iterators, including the past the end iterator, and all references to the elements are invalidated. If no reallocation takes place, no iterators or references are invalidated.
@@ -214,45 +338,43 @@ public:
             return end()-1;
         }
         auto ipos = pos - cbegin();
+        // value may refer to an element of this container
+        T copy {value};
         if (m_size == m_capacity)
             grow_and_copy_from<T>((m_size + 1) * CapacityFactor, *this);
 
-        auto curr = end();
-        while ((curr - begin()) != ipos) {
-            *curr = std::move(*(curr-1));
-            --curr;
+        // The slot past the end is raw memory, the rest are shifted by assignment
+        new (m_buffer_p + m_size) T{ std::move(m_buffer_p[m_size - 1]) };
+        for (size_t i = m_size - 1; i > static_cast<size_t>(ipos); --i) {
+            m_buffer_p[i] = std::move(m_buffer_p[i - 1]);
         }
-        *curr = value;
+        m_buffer_p[ipos] = std::move(copy);
         ++m_size;
-        return curr;
+        return begin() + ipos;
     }
 
     //inserts elements from range [first, last) before pos.
     template< class InputIt >
     iterator insert( const_iterator pos, InputIt first, InputIt last ) {
-        auto count = std::distance(first, last);
-        if (pos == cend()) {
-            if (m_size + count > m_capacity)
-                grow_and_copy_from<T>((m_size + count) * CapacityFactor, *this);
-            auto rit = end();
-            while (first != last) {
-                push_back(*first++);
-            }
-            return rit;
-        }
-
-        auto ipos = pos - begin();
+        size_t count = std::distance(first, last);
+        size_t ipos = pos - cbegin();
         if (m_size + count > m_capacity)
             grow_and_copy_from<T>((m_size + count) * CapacityFactor, *this);
-        pos = begin() + ipos;
-        auto cur = end() - 1;
-        while (cur != pos-1) {
-            *(cur + count) = std::move(*cur);
-            --cur;
+
+        // Shift the tail [ipos, m_size) by count, constructing the slots past the old end
+        for (size_t i = m_size; i-- > ipos; ) {
+            if (i + count >= m_size) {
+                new (m_buffer_p + i + count) T{ std::move(m_buffer_p[i]) };
+            } else {
+                m_buffer_p[i + count] = std::move(m_buffer_p[i]);
+            }
         }
-        cur = begin() + ipos;
-        while (first != last) {
-            *cur++ = *first++;
+        for (size_t i = ipos; first != last; ++i, ++first) {
+            if (i < m_size) {
+                m_buffer_p[i] = *first;
+            } else {
+                new (m_buffer_p + i) T{ *first };
+            }
         }
         m_size += count;
         return begin() + ipos;
@@ -262,36 +384,40 @@ public:
     // Return Iterator following the last removed element.
     // If pos refers to the last element, then the end() iterator is returned.
     iterator erase( const_iterator pos ) {
-        if (!is_empty() && pos != end()) {
-            auto cur = begin() + (pos-cbegin());
-            cur->~T();
-            while ((cur) != end()) {
-                *cur = std::move(*(cur + 1));
-                ++cur;
+        auto ipos = pos - cbegin();
+        if (!is_empty() && pos != cend()) {
+            for (size_t i = ipos; i + 1 < m_size; ++i) {
+                m_buffer_p[i] = std::move(m_buffer_p[i + 1]);
             }
+            m_buffer_p[m_size - 1].~T();
             m_size--;
         }
-        return begin() + (pos-cbegin());
+        return begin() + ipos;
     }
 
     // Removes the elements in the range [first, last).
     iterator erase( const_iterator first, const_iterator last ) {
         auto count = last - first;
+        auto ifirst = first - cbegin();
         if (!is_empty() && count > 0) {
-            auto it = begin() + (first - cbegin());
-            auto it2 = begin() + (last - cbegin());
-            while (it != last) {
-                it->~T();
-                *it++ = std::move(*it2++);
+            for (size_t i = ifirst; i + count < m_size; ++i) {
+                m_buffer_p[i] = std::move(m_buffer_p[i + count]);
             }
-            it2 = it + count;
-            while (it2 < end()) {
-                *it++ = std::move(*it2++);
+            for (size_t i = m_size - count; i < m_size; ++i) {
+                m_buffer_p[i].~T();
             }
             m_size -= count;
-            return begin() + (first - begin());
         }
-        return begin();
+        return begin() + ifirst;
+    }
+
+    // Direct access to the underlying contiguous storage
+    T* data() noexcept {
+        return m_buffer_p;
+    }
+
+    const T* data() const noexcept {
+        return m_buffer_p;
     }
 
     T& front() {
@@ -379,20 +505,39 @@ public:
     }
 
 private:
+    static constexpr bool OverAligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    // Raw storage for count elements, honours alignment of over-aligned types (e.g. cache line padded slots)
+    static void* allocate (size_t count) {
+        if constexpr (OverAligned) {
+            return ::operator new (count * sizeof(T), std::align_val_t(alignof(T)));
+        } else {
+            return ::operator new (count * sizeof(T));
+        }
+    }
+
+    static void deallocate (void* buffer_p) noexcept {
+        if constexpr (OverAligned) {
+            ::operator delete (buffer_p, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete (buffer_p);
+        }
+    }
+
     // Destroy this object calling destructors
     void destroy () {
         for (int i=0; i<m_size; ++i) {
             m_buffer_p[i].~T();
         }
-        ::operator delete (m_buffer_p);
+        deallocate (m_buffer_p);
     }
 
     // Specialization for PODs
     template <class Typ, std::enable_if_t<std::is_pod<Typ>::value, int> = 0>
     void grow_and_copy_from (size_t new_cap, const my_vector& source) {
-        auto rawbuff_p = ::operator new (new_cap * sizeof(Typ));
+        auto rawbuff_p = allocate (new_cap);
         std::memcpy(rawbuff_p, source.m_buffer_p, source.m_size * sizeof(Typ) );
-        ::operator delete (m_buffer_p);
+        deallocate (m_buffer_p);
         m_buffer_p = static_cast<T*>(rawbuff_p);
         m_capacity = new_cap;
         m_size = source.m_size;
@@ -401,14 +546,14 @@ private:
     // Specialization for NON PODs
     template <class Typ, std::enable_if_t<! std::is_pod<Typ>::value, int> = 0>
     void grow_and_copy_from (size_t new_cap, const my_vector& source) {
-        auto rawbuff_p = ::operator new (new_cap * sizeof(Typ));
+        auto rawbuff_p = allocate (new_cap);
         auto new_size = source.m_size;
         if (this == &source) {
             // Moving elements when reallocating itself
             for (int i=0; i<source.m_size; ++i) {
                 new (static_cast<char*>(rawbuff_p) + i*sizeof(Typ)) Typ { std::move(source.m_buffer_p[i]) };
             }
-            ::operator delete (m_buffer_p);
+            deallocate (m_buffer_p);
         } else {
             for (int i=0; i<source.m_size; ++i) {
                 new (static_cast<char*>(rawbuff_p) + i*sizeof(Typ)) Typ {source.m_buffer_p[i]};
@@ -421,6 +566,23 @@ private:
         m_size = new_size;
     }
 
+    // Copies elements of source into the raw buffer of this container by chunks, one chunk per thread.
+    // Specialization for PODs
+    template <class Typ, std::enable_if_t<std::is_pod<Typ>::value, int> = 0>
+    void parallel_copy_from (const parallel_policy& policy, const my_vector& source) {
+        detail::parallel_for(policy, source.m_size, [this, &source](size_t first, size_t last) {
+            std::memcpy(m_buffer_p + first, source.m_buffer_p + first, (last - first) * sizeof(Typ));
+        });
+    }
+
+    // Specialization for NON PODs
+    template <class Typ, std::enable_if_t<! std::is_pod<Typ>::value, int> = 0>
+    void parallel_copy_from (const parallel_policy& policy, const my_vector& source) {
+        detail::parallel_uninitialized_construct(policy, m_buffer_p, source.m_size, [&source](Typ* p, size_t i) {
+            new (p) Typ {source.m_buffer_p[i]};
+        });
+    }
+
     //
     // Iterator, see https://en.cppreference.com/w/cpp/iterator/iterator
     //
@@ -0,0 +1,261 @@
+#ifndef MY_VECTOR_EXPR_H
+#define MY_VECTOR_EXPR_H
+
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "my_vector.h"
+
+namespace cpp_training {
+
+// Lazy element-wise arithmetic over my_vector.
+// b * 2.0f + c builds a small tree of nodes holding pointers into b and c; nothing is computed until it is
+// assigned to a my_vector (or passed to sum / dot), which runs a single loop over all operands:
+// no intermediate my_vector is allocated, each operand is read once, and the loop body is plain
+// arithmetic on array elements, which the compiler can vectorize.
+// Operands are my_vectors, expressions and scalars; a scalar is converted to the element type of the other
+// operand, so b * 2.0 over floats stays in float. Operand sizes must match, std::invalid_argument otherwise.
+// my_vector's own comparison operators compare whole vectors, so element-wise comparisons need an expression
+// operand: lazy(a) < 0.5f or lazy(a) < lazy(b) give a mask for where(), sum() counts its true elements.
+template <typename E>
+struct my_vector_expr {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+namespace detail {
+
+// Size of a scalar operand, which matches any size
+constexpr size_t ExprBroadcast = SIZE_MAX;
+
+inline size_t expr_size(size_t lhs, size_t rhs) {
+    if (lhs != ExprBroadcast && rhs != ExprBroadcast && lhs != rhs) throw std::invalid_argument("operand sizes differ");
+    return lhs != ExprBroadcast ? lhs : rhs;
+}
+
+// Leaf reading a my_vector
+template <typename T>
+class expr_ref : public my_vector_expr<expr_ref<T>> {
+public:
+    using value_type = T;
+
+    expr_ref(const T* data, size_t size) : m_data_p(data), m_size(size) {}
+
+    size_t size() const { return m_size; }
+
+    T operator [] (size_t i) const { return m_data_p[i]; }
+
+private:
+    const T* m_data_p;
+    size_t m_size;
+};
+
+template <typename T>
+class expr_scalar {
+public:
+    using value_type = T;
+
+    explicit expr_scalar(T value) : m_value(value) {}
+
+    size_t size() const { return ExprBroadcast; }
+
+    T operator [] (size_t) const { return m_value; }
+
+private:
+    T m_value;
+};
+
+template <typename Op, typename X>
+class expr_unary : public my_vector_expr<expr_unary<Op, X>> {
+public:
+    using value_type = decltype(Op()(std::declval<typename X::value_type>()));
+
+    explicit expr_unary(const X& x) : m_x(x) {}
+
+    size_t size() const { return m_x.size(); }
+
+    value_type operator [] (size_t i) const { return Op()(m_x[i]); }
+
+private:
+    X m_x;
+};
+
+template <typename Op, typename L, typename R>
+class expr_binary : public my_vector_expr<expr_binary<Op, L, R>> {
+public:
+    using value_type = decltype(Op()(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+
+    expr_binary(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs), m_size(expr_size(lhs.size(), rhs.size())) {}
+
+    size_t size() const { return m_size; }
+
+    value_type operator [] (size_t i) const { return Op()(m_lhs[i], m_rhs[i]); }
+
+private:
+    L m_lhs;
+    R m_rhs;
+    size_t m_size;
+};
+
+template <typename M, typename X, typename Y>
+class expr_where : public my_vector_expr<expr_where<M, X, Y>> {
+public:
+    using value_type = std::common_type_t<typename X::value_type, typename Y::value_type>;
+
+    expr_where(const M& mask, const X& x, const Y& y)
+        : m_mask(mask), m_x(x), m_y(y), m_size(expr_size(mask.size(), expr_size(x.size(), y.size()))) {}
+
+    size_t size() const { return m_size; }
+
+    // Both sides are evaluated, so the compiler can turn the choice into a blend
+    value_type operator [] (size_t i) const {
+        value_type x = m_x[i];
+        value_type y = m_y[i];
+        return m_mask[i] ? x : y;
+    }
+
+private:
+    M m_mask;
+    X m_x;
+    Y m_y;
+    size_t m_size;
+};
+
+template <typename X>
+struct is_my_vector : std::false_type {};
+
+template <typename T>
+struct is_my_vector<my_vector<T>> : std::true_type {};
+
+template <typename X>
+struct is_expr : std::is_base_of<my_vector_expr<X>, X> {};
+
+// my_vectors and expressions, which have elements
+template <typename X>
+struct is_vector_operand : std::integral_constant<bool, is_my_vector<X>::value || is_expr<X>::value> {};
+
+template <typename L, typename R>
+struct arithmetic_operands : std::integral_constant<bool,
+    (is_vector_operand<L>::value && (is_vector_operand<R>::value || std::is_arithmetic<R>::value)) ||
+    (std::is_arithmetic<L>::value && is_vector_operand<R>::value)> {};
+
+// As arithmetic_operands, without my_vector, which compares as a whole
+template <typename L, typename R>
+struct comparison_operands : std::integral_constant<bool,
+    (is_expr<L>::value && (is_expr<R>::value || std::is_arithmetic<R>::value)) ||
+    (std::is_arithmetic<L>::value && is_expr<R>::value)> {};
+
+template <typename T>
+expr_ref<T> to_node(const my_vector<T>& v) { return expr_ref<T>(v.data(), v.size()); }
+
+template <typename E>
+const E& to_node(const my_vector_expr<E>& e) { return e.self(); }
+
+template <typename X>
+using node_type = std::decay_t<decltype(to_node(std::declval<const X&>()))>;
+
+// Element type of an operand, a scalar is its own
+template <typename X, typename = void>
+struct operand_value { using type = X; };
+
+template <typename X>
+struct operand_value<X, std::enable_if_t<is_vector_operand<X>::value>> { using type = typename node_type<X>::value_type; };
+
+// Node of an operand, a scalar is converted to V
+template <typename V, typename X>
+auto to_node_as(const X& x) {
+    if constexpr (is_vector_operand<X>::value) {
+        return to_node(x);
+    } else {
+        return expr_scalar<V>(static_cast<V>(x));
+    }
+}
+
+template <typename Op, typename L, typename R>
+auto make_binary(const L& lhs, const R& rhs) {
+    // The element type of the vector side, the other one may be a scalar
+    using V = typename operand_value<std::conditional_t<is_vector_operand<L>::value, L, R>>::type;
+    auto l = to_node_as<V>(lhs);
+    auto r = to_node_as<V>(rhs);
+    return expr_binary<Op, decltype(l), decltype(r)>(l, r);
+}
+
+}
+
+// Element-wise view of v for comparisons
+template <typename T>
+detail::expr_ref<T> lazy(const my_vector<T>& v) { return detail::to_node(v); }
+
+template <typename L, typename R, std::enable_if_t<detail::arithmetic_operands<L, R>::value, int> = 0>
+auto operator + (const L& lhs, const R& rhs) { return detail::make_binary<std::plus<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::arithmetic_operands<L, R>::value, int> = 0>
+auto operator - (const L& lhs, const R& rhs) { return detail::make_binary<std::minus<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::arithmetic_operands<L, R>::value, int> = 0>
+auto operator * (const L& lhs, const R& rhs) { return detail::make_binary<std::multiplies<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::arithmetic_operands<L, R>::value, int> = 0>
+auto operator / (const L& lhs, const R& rhs) { return detail::make_binary<std::divides<>>(lhs, rhs); }
+
+template <typename X, std::enable_if_t<detail::is_vector_operand<X>::value, int> = 0>
+auto operator - (const X& x) { return detail::expr_unary<std::negate<>, detail::node_type<X>>(detail::to_node(x)); }
+
+template <typename L, typename R, std::enable_if_t<detail::comparison_operands<L, R>::value, int> = 0>
+auto operator < (const L& lhs, const R& rhs) { return detail::make_binary<std::less<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::comparison_operands<L, R>::value, int> = 0>
+auto operator <= (const L& lhs, const R& rhs) { return detail::make_binary<std::less_equal<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::comparison_operands<L, R>::value, int> = 0>
+auto operator > (const L& lhs, const R& rhs) { return detail::make_binary<std::greater<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::comparison_operands<L, R>::value, int> = 0>
+auto operator >= (const L& lhs, const R& rhs) { return detail::make_binary<std::greater_equal<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::comparison_operands<L, R>::value, int> = 0>
+auto operator == (const L& lhs, const R& rhs) { return detail::make_binary<std::equal_to<>>(lhs, rhs); }
+
+template <typename L, typename R, std::enable_if_t<detail::comparison_operands<L, R>::value, int> = 0>
+auto operator != (const L& lhs, const R& rhs) { return detail::make_binary<std::not_equal_to<>>(lhs, rhs); }
+
+// x where mask holds, y elsewhere. x and y may be scalars
+template <typename M, typename X, typename Y, std::enable_if_t<detail::is_vector_operand<M>::value, int> = 0>
+auto where(const M& mask, const X& x, const Y& y) {
+    using V = std::common_type_t<typename detail::operand_value<X>::type, typename detail::operand_value<Y>::type>;
+    auto m = detail::to_node(mask);
+    auto xn = detail::to_node_as<V>(x);
+    auto yn = detail::to_node_as<V>(y);
+    return detail::expr_where<decltype(m), decltype(xn), decltype(yn)>(m, xn, yn);
+}
+
+// Sum of the elements, the number of true ones for a mask.
+// Lanes independent partial sums break the dependency chain of the additions and map onto one vector register
+template <typename X, std::enable_if_t<detail::is_vector_operand<X>::value, int> = 0>
+auto sum(const X& x) {
+    constexpr size_t Lanes = 8;
+    const auto& e = detail::to_node(x);
+    using V = typename detail::node_type<X>::value_type;
+    using A = std::conditional_t<std::is_same<V, bool>::value, size_t, V>;
+    A partial[Lanes] = {};
+    auto n = e.size();
+    size_t i = 0;
+    for (; i + Lanes <= n; i += Lanes) {
+        for (size_t k = 0; k < Lanes; ++k) partial[k] += e[i + k];
+    }
+    for (; i < n; ++i) partial[0] += e[i];
+    A result = A();
+    for (size_t k = 0; k < Lanes; ++k) result += partial[k];
+    return result;
+}
+
+// Sum of x * y in one pass
+template <typename X, typename Y, std::enable_if_t<detail::is_vector_operand<X>::value && detail::is_vector_operand<Y>::value, int> = 0>
+auto dot(const X& x, const Y& y) {
+    return sum(detail::make_binary<std::multiplies<>>(x, y));
+}
+
+}
+
+#endif // MY_VECTOR_EXPR_H
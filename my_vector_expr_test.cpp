@@ -0,0 +1,87 @@
+// This is an independent project of an individual developer. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "gtest/gtest.h"
+#include "my_vector_expr.h"
+#include <cmath>
+#include <random>
+
+using namespace cpp_training;
+
+namespace {
+
+my_vector<float> random_floats(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    my_vector<float> result;
+    for (size_t i = 0; i < n; ++i) result.push_back(dist(gen));
+    return result;
+}
+
+}
+
+TEST(MyVectorExprTest, Arithmetic) {
+    my_vector<float> b {1, 2, 3, 4};
+    my_vector<float> c {10, 20, 30, 40};
+    my_vector<float> a;
+    a = b * 2.0f + c;
+    EXPECT_EQ(a, (my_vector<float>{12, 24, 36, 48}));
+    a = (a - c) / b - 1;
+    EXPECT_EQ(a, (my_vector<float>{1, 1, 1, 1}));
+    a = -b + 2.0 * c;
+    EXPECT_EQ(a, (my_vector<float>{19, 38, 57, 76}));
+
+    // The target may be an operand
+    a = a * a - a;
+    EXPECT_EQ(a[0], 19 * 19 - 19);
+
+    my_vector<float> built(b + c);
+    EXPECT_EQ(built, (my_vector<float>{11, 22, 33, 44}));
+    my_vector<int> truncated(b * 1.5f);
+    EXPECT_EQ(truncated, (my_vector<int>{1, 3, 4, 6}));
+
+    // Scalars take the element type of the other operand
+    static_assert(std::is_same<decltype((b * 2.0)[0]), float>::value, "float stays float");
+
+    my_vector<float> shorter {1, 2};
+    EXPECT_THROW(a = b + shorter, std::invalid_argument);
+}
+
+TEST(MyVectorExprTest, MasksAndReductions) {
+    my_vector<float> x {-2, -1, 0, 1, 2};
+    my_vector<float> y {5, 5, 5, 5, 5};
+    my_vector<float> clamped;
+    clamped = where(lazy(x) < 0.0f, 0.0f, x);
+    EXPECT_EQ(clamped, (my_vector<float>{0, 0, 0, 1, 2}));
+    clamped = where(x * x >= 1, y, -y);
+    EXPECT_EQ(clamped, (my_vector<float>{5, 5, -5, 5, 5}));
+
+    EXPECT_EQ(sum(lazy(x) > lazy(y) - 4.5f), 2);
+    EXPECT_EQ(sum(x), 0);
+    EXPECT_EQ(sum(x + 1), 5);
+    EXPECT_EQ(dot(x, y), 0);
+    EXPECT_EQ(dot(x, x), 10);
+    my_vector<bool> mask(lazy(x) == 0.0f);
+    EXPECT_EQ(mask, (my_vector<bool>{false, false, true, false, false}));
+
+    // The whole vector comparisons are unchanged
+    EXPECT_TRUE(x < y);
+    EXPECT_FALSE(x == y);
+}
+
+TEST(MyVectorExprTest, MatchesEagerLoops) {
+    constexpr size_t N = 10007;
+    auto a = random_floats(N, 1);
+    auto b = random_floats(N, 2);
+    auto c = random_floats(N, 3);
+    my_vector<float> r(a * b + where(lazy(c) > 0.0f, c, 0.5f * a) - 1.0f);
+    double expected_sum = 0;
+    double expected_dot = 0;
+    for (size_t i = 0; i < N; ++i) {
+        float e = a[i] * b[i] + (c[i] > 0.0f ? c[i] : 0.5f * a[i]) - 1.0f;
+        ASSERT_FLOAT_EQ(r[i], e);
+        expected_sum += r[i];
+        expected_dot += static_cast<double>(a[i]) * b[i];
+    }
+    EXPECT_NEAR(sum(r), expected_sum, 1e-2);
+    EXPECT_NEAR(dot(a, b), expected_dot, 1e-2);
+}
@@ -9,6 +9,8 @@
 #include <numeric>
 #include <vector>
 #include <list>
+#include <atomic>
+#include <string>
 
 using namespace cpp_training;
 
@@ -710,6 +712,68 @@ TEST(MyVectorTest, EraseRange) {
     }
 }
 
+namespace {
+// Counts live objects and marks dead ones, so assigning to a raw slot or leaking a moved-from element shows up
+struct Tracked {
+    static constexpr int Alive = 0x600d;
+    static int live;
+    int state = Alive;
+    std::string value;
+    Tracked(const char* v = "") : value(v) { ++live; }
+    Tracked(const Tracked& rhs) : value(rhs.value) { ++live; }
+    Tracked(Tracked&& rhs) noexcept : value(std::move(rhs.value)) { ++live; }
+    Tracked& operator = (const Tracked& rhs) { EXPECT_EQ(state, Alive); value = rhs.value; return *this; }
+    Tracked& operator = (Tracked&& rhs) noexcept { EXPECT_EQ(state, Alive); value = std::move(rhs.value); return *this; }
+    ~Tracked() { EXPECT_EQ(state, Alive); state = 0; --live; }
+};
+int Tracked::live = 0;
+
+std::string joined(const my_vector<Tracked>& v) {
+    std::string result;
+    for (auto& t : v) result += t.value;
+    return result;
+}
+}
+
+TEST(MyVectorTest, InsertEraseNonTrivial) {
+    {
+        my_vector<Tracked> v;
+        v.reserve(20);
+        for (auto s : {"a", "b", "c", "d"}) v.push_back(s);
+        // The tail is shifted into raw slots past the end, which must be constructed rather than assigned
+        v.insert(v.begin() + 1, Tracked("x"));
+        EXPECT_EQ(joined(v), "axbcd");
+        my_vector<Tracked> range {"1", "2", "3"};
+        v.insert(v.begin() + 4, range.begin(), range.end());
+        EXPECT_EQ(joined(v), "axbc123d");
+        v.insert(v.begin() + 7, range.begin(), range.end());
+        EXPECT_EQ(joined(v), "axbc123123d");
+        // Inserting an element of the vector itself
+        v.insert(v.begin(), v[3]);
+        EXPECT_EQ(joined(v), "caxbc123123d");
+        EXPECT_EQ(Tracked::live, static_cast<int>(v.size() + range.size()));
+
+        // The vacated slots at the end are destroyed
+        auto it = v.erase(v.begin() + 2);
+        EXPECT_EQ(it, v.begin() + 2);
+        EXPECT_EQ(joined(v), "cabc123123d");
+        it = v.erase(v.begin() + 4, v.begin() + 7);
+        EXPECT_EQ(it, v.begin() + 4);
+        EXPECT_EQ(it->value, "1");
+        EXPECT_EQ(joined(v), "cabc123d");
+        EXPECT_EQ(Tracked::live, static_cast<int>(v.size() + range.size()));
+
+        // An empty range in the middle returns its position, not begin()
+        it = v.erase(v.begin() + 3, v.begin() + 3);
+        EXPECT_EQ(it, v.begin() + 3);
+        it = v.erase(v.begin() + 5, v.end());
+        EXPECT_EQ(it, v.end());
+        EXPECT_EQ(joined(v), "cabc1");
+        EXPECT_EQ(Tracked::live, static_cast<int>(v.size() + range.size()));
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
 class Bar {
 public:
     Bar () = default;
@@ -863,3 +927,124 @@ TEST(MyVectorTest, Algorithms) {
     std::copy(vec.begin(), vec.end(), to_foovec.begin());
     std::cout << "After copy: " << to_foovec << std::endl;
 }
+
+TEST(MyVectorTest, Resize3) {
+    my_vector<std::string> cont {"a", "b"};
+    cont.resize(4, "c");
+    EXPECT_EQ(cont, (my_vector<std::string>{"a", "b", "c", "c"}));
+    cont.resize(1);
+    EXPECT_EQ(cont, (my_vector<std::string>{"a"}));
+}
+
+TEST(MyVectorTest, ResizeAndOverwrite) {
+    my_vector<int> vec {1, 2, 3};
+    vec.resize_and_overwrite(10, [](int* p, size_t count) {
+        EXPECT_EQ(count, 10);
+        EXPECT_EQ(p[2], 3);
+        for (int i = 3; i < 6; ++i) p[i] = i * i;
+        return size_t{6};
+    });
+    EXPECT_EQ(vec, (my_vector<int>{1, 2, 3, 9, 16, 25}));
+    // Enough capacity: no reallocation
+    auto data = vec.data();
+    vec.resize_and_overwrite(8, [](int* p, size_t) { p[0] = 0; return size_t{2}; });
+    EXPECT_EQ(vec, (my_vector<int>{0, 2}));
+    EXPECT_EQ(vec.data(), data);
+
+    my_vector<std::string> strs {"a"};
+    strs.resize_and_overwrite(3, [](std::string* p, size_t) { p[1] = "b"; return size_t{2}; });
+    EXPECT_EQ(strs, (my_vector<std::string>{"a", "b"}));
+}
+
+TEST(MyVectorTest, ParallelConstruction) {
+    const size_t count = 200000;
+    my_vector<int> vec(parallel_policy{4}, count, 7);
+    EXPECT_EQ(vec.size(), count);
+    EXPECT_EQ(vec.capacity(), static_cast<size_t>(count * my_vector<int>::CapacityFactor));
+    EXPECT_EQ(std::count(vec.begin(), vec.end(), 7), count);
+
+    my_vector<std::string> strs(par, count, "abc");
+    EXPECT_EQ(strs.size(), count);
+    EXPECT_EQ(strs[0], "abc");
+    EXPECT_EQ(strs[count - 1], "abc");
+
+    // Small vectors are constructed by the calling thread only
+    my_vector<Foo> foo_vec(par, 3, Foo{5});
+    EXPECT_EQ(foo_vec.size(), 3);
+    EXPECT_EQ(foo_vec[2], Foo{5});
+}
+
+TEST(MyVectorTest, ParallelCopy) {
+    const size_t count = 150000;
+    my_vector<int> src(count);
+    std::iota(src.begin(), src.end(), 0);
+    my_vector<int> copy(parallel_policy{3}, src);
+    EXPECT_EQ(copy.size(), src.size());
+    EXPECT_EQ(copy.capacity(), src.capacity());
+    EXPECT_EQ(copy, src);
+
+    my_vector<std::string> strs(count, "xyz");
+    strs[count / 2] = "middle";
+    my_vector<std::string> str_copy(parallel_policy{3}, strs);
+    EXPECT_EQ(str_copy, strs);
+}
+
+TEST(MyVectorTest, ParallelResizeFill) {
+    my_vector<int> vec {1, 2, 3};
+    vec.resize(par, 100000, 9);
+    EXPECT_EQ(vec.size(), 100000);
+    EXPECT_EQ(vec[2], 3);
+    EXPECT_EQ(vec[3], 9);
+    EXPECT_EQ(vec[99999], 9);
+
+    vec.resize(par, 2);
+    EXPECT_EQ(vec, (my_vector<int>{1, 2}));
+
+    my_vector<double> dbl(100000, 1.0);
+    dbl.fill(parallel_policy{4}, 2.5);
+    EXPECT_EQ(std::count(dbl.begin(), dbl.end(), 2.5), 100000);
+    dbl.fill(0.5);
+    EXPECT_EQ(std::count(dbl.begin(), dbl.end(), 0.5), 100000);
+}
+
+TEST(MyVectorTest, PolicyOverloads) {
+    // The same generic code with either policy
+    auto build = [](const auto& policy) {
+        my_vector<int> vec(policy, 1000, 7);
+        my_vector<int> copy(policy, vec);
+        copy.resize(policy, 1500, 8);
+        copy.fill(policy, 3);
+        return std::make_pair(vec, copy);
+    };
+    auto sequential = build(seq);
+    auto parallel = build(par);
+    EXPECT_EQ(sequential, parallel);
+    EXPECT_EQ(sequential.first, my_vector<int>(1000, 7));
+    EXPECT_EQ(sequential.second, my_vector<int>(1500, 3));
+}
+
+namespace {
+// Copied from several threads at once
+struct ThrowingCopy {
+    static std::atomic<int> live;
+    static std::atomic<int> copies_left;
+    ThrowingCopy() { ++live; }
+    ThrowingCopy(const ThrowingCopy&) {
+        if (copies_left-- == 0) throw std::runtime_error("copy failed");
+        ++live;
+    }
+    ~ThrowingCopy() { --live; }
+};
+std::atomic<int> ThrowingCopy::live {0};
+std::atomic<int> ThrowingCopy::copies_left {0};
+}
+
+TEST(MyVectorTest, ParallelConstructionRollback) {
+    {
+        ThrowingCopy proto;
+        ThrowingCopy::copies_left = 100000;
+        EXPECT_THROW((my_vector<ThrowingCopy>(parallel_policy{4}, 200000, proto)), std::runtime_error);
+        EXPECT_EQ(ThrowingCopy::live, 1);
+    }
+    EXPECT_EQ(ThrowingCopy::live, 0);
+}